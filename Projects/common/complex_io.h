@@ -0,0 +1,402 @@
+#ifndef COMPLEX_IO_H
+#define COMPLEX_IO_H
+
+/*
+    Shared complex-vector file input for the MAT320 projects.
+
+    Text (one number per line, '#' lines skipped), any of
+        a b          a + bi        a - bi        a+bi       a-bi
+    parsed with std::from_chars straight out of a memory-mapped
+    file: no getline, no istringstream, no locale. Pipes, /dev/stdin
+    and <(...) cannot be mapped and are read() into a buffer instead.
+
+    Binary (.cvec), little-endian:
+        offset 0   char[4]   "CVEC"
+        offset 4   uint32    version (1)
+        offset 8   uint64    count
+        offset 16  double[2 * count]   re, im interleaved
+    The payload has exactly the layout of std::complex<double>[count],
+    so a mapped file is used in place with zero copies.
+
+    ReadComplexFile() looks at the first four bytes and picks the
+    right path, so every CLI takes either format.
+
+    Output goes through ComplexWriter: values are formatted with
+    std::to_chars into one 64 KB buffer and written in blocks, with
+    no per-line flush. Text matches the old iostream output byte
+    for byte; WriteComplexBinary skips formatting altogether.
+*/
+
+#include <charconv>
+#include <cerrno>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct ComplexFileHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t count;
+};
+
+const char complexFileMagic[4] = {'C', 'V', 'E', 'C'};
+const std::uint32_t complexFileVersion = 1;
+
+/*
+    Read-only memory map of a whole file, unmapped on destruction.
+    IsOpen() is false for anything but a non-empty regular file.
+    With _writable the pages are copy-on-write, so an in-place
+    transform can run on them without touching the file on disk.
+*/
+class MappedFile
+{
+public:
+    MappedFile(const std::string& _filename, bool _writable = false)
+    : data_(nullptr), size_(0)
+    {
+        int fd = open(_filename.c_str(), O_RDONLY);
+        if(fd < 0) return;
+        struct stat info;
+        if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+        {
+            size_ = static_cast<size_t>(info.st_size);
+            int protect = _writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+            void* mapped = mmap(nullptr, size_, protect, MAP_PRIVATE, fd, 0);
+            if(mapped == MAP_FAILED) size_ = 0;
+            else
+            {
+                data_ = static_cast<char*>(mapped);
+                madvise(mapped, size_, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+    }
+    ~MappedFile()
+    {
+        if(data_) munmap(data_, size_);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsOpen() const { return data_ != nullptr; }
+    char* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+private:
+    char* data_;
+    size_t size_;
+};
+
+// True if the mapped bytes start with a valid .cvec header
+inline bool IsComplexBinary(const char* data, size_t size)
+{
+    if(size < sizeof(ComplexFileHeader)) return false;
+    ComplexFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    return std::memcmp(header.magic, complexFileMagic, 4) == 0
+        && header.version == complexFileVersion
+        && header.count <= (size - sizeof(header)) / (2 * sizeof(double));
+}
+
+/*
+    Zero-copy view of a binary complex file.
+    Values() points into the mapping; it stays valid as long as
+    the view does. IsOpen() is false for missing or text files.
+*/
+class ComplexFileView
+{
+public:
+    ComplexFileView(const std::string& _filename, bool _writable = false)
+    : file_(_filename, _writable), values_(nullptr), count_(0)
+    {
+        if(file_.IsOpen() && IsComplexBinary(file_.Data(), file_.Size()))
+        {
+            ComplexFileHeader header;
+            std::memcpy(&header, file_.Data(), sizeof(header));
+            values_ = reinterpret_cast<std::complex<double>*>(file_.Data() + sizeof(header));
+            count_ = static_cast<size_t>(header.count);
+        }
+    }
+
+    bool IsOpen() const { return values_ != nullptr; }
+    std::complex<double>* Values() const { return values_; }
+    size_t Count() const { return count_; }
+
+private:
+    MappedFile file_;
+    std::complex<double>* values_;
+    size_t count_;
+};
+
+/*
+    Binary complex file of count values, created (or truncated) at
+    full size with its header written and mapped shared, so values
+    stored through Values() end up in the file. For results too big
+    to build in memory first; the pages are flushed by the kernel,
+    and on destruction.
+*/
+class ComplexFileOutput
+{
+public:
+    ComplexFileOutput(const std::string& _filename, size_t _count)
+    : data_(nullptr), size_(sizeof(ComplexFileHeader) + _count * sizeof(std::complex<double>))
+    , count_(_count)
+    {
+        int fd = open(_filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0) return;
+        if(ftruncate(fd, static_cast<off_t>(size_)) == 0)
+        {
+            void* mapped = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if(mapped != MAP_FAILED)
+            {
+                data_ = static_cast<char*>(mapped);
+                ComplexFileHeader header;
+                std::memcpy(header.magic, complexFileMagic, 4);
+                header.version = complexFileVersion;
+                header.count = _count;
+                std::memcpy(data_, &header, sizeof(header));
+            }
+        }
+        close(fd);
+    }
+    ~ComplexFileOutput()
+    {
+        if(data_) munmap(data_, size_);
+    }
+    ComplexFileOutput(const ComplexFileOutput&) = delete;
+    ComplexFileOutput& operator=(const ComplexFileOutput&) = delete;
+
+    bool IsOpen() const { return data_ != nullptr; }
+    std::complex<double>* Values() const
+    {
+        return reinterpret_cast<std::complex<double>*>(data_ + sizeof(ComplexFileHeader));
+    }
+    size_t Count() const { return count_; }
+
+private:
+    char* data_;
+    size_t size_;
+    size_t count_;
+};
+
+// Parse one line [begin, end) of text. Returns false for blank,
+// comment or malformed lines.
+inline bool ParseComplexLine(const char* begin, const char* end, std::complex<double>& value)
+{
+    const char* at = begin;
+    auto skipSpace = [&at, end]()
+    {
+        while(at < end && (*at == ' ' || *at == '\t' || *at == '\r')) ++at;
+    };
+    // from_chars takes '-' but not a leading '+'
+    auto number = [&at, end](double& result)
+    {
+        if(at < end && *at == '+') ++at;
+        auto parsed = std::from_chars(at, end, result);
+        if(parsed.ec != std::errc()) return false;
+        at = parsed.ptr;
+        return true;
+    };
+
+    double real, imag;
+    skipSpace();
+    if(!number(real)) return false;
+    skipSpace();
+    // "a + bi" / "a - bi": the sign is its own token
+    double sign = 1.0;
+    if(at < end && (*at == '+' || *at == '-'))
+    {
+        sign = (*at == '-') ? -1.0 : 1.0;
+        ++at;
+        skipSpace();
+    }
+    if(!number(imag)) return false;
+    value = std::complex<double>(real, sign * imag);
+    return true;
+}
+
+// Text parse of a whole buffer, one value per line
+inline std::vector<std::complex<double>> ParseComplexText(const char* data, size_t size)
+{
+    std::vector<std::complex<double>> numbers;
+    // rough guess from line length, saves the regrowth copies
+    numbers.reserve(size / 24 + 1);
+    const char* at = data;
+    const char* end = data + size;
+    while(at < end)
+    {
+        const char* lineEnd = static_cast<const char*>(std::memchr(at, '\n', end - at));
+        if(!lineEnd) lineEnd = end;
+        std::complex<double> value;
+        if(*at != '#' && ParseComplexLine(at, lineEnd, value))
+        {
+            numbers.emplace_back(value);
+        }
+        at = lineEnd + 1;
+    }
+    return numbers;
+}
+
+// Whole file through read(), for what cannot be mapped: pipes,
+// /dev/stdin, <(...). False if it cannot be opened or read.
+inline bool ReadWholeFile(const std::string& filename, std::vector<char>& buffer)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    buffer.clear();
+    const size_t chunk = 1 << 16;
+    ssize_t got = 0;
+    do
+    {
+        size_t used = buffer.size();
+        buffer.resize(used + chunk);
+        got = read(fd, buffer.data() + used, chunk);
+        buffer.resize(used + (got > 0 ? static_cast<size_t>(got) : 0));
+    } while(got > 0 || (got < 0 && errno == EINTR));
+    close(fd);
+    return got == 0;
+}
+
+// Text or binary values out of a whole file's bytes
+inline std::vector<std::complex<double>> ParseComplexData(const char* data, size_t size)
+{
+    if(IsComplexBinary(data, size))
+    {
+        ComplexFileHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        std::vector<std::complex<double>> numbers(static_cast<size_t>(header.count));
+        std::memcpy(numbers.data(), data + sizeof(header), numbers.size() * sizeof(std::complex<double>));
+        return numbers;
+    }
+    return ParseComplexText(data, size);
+}
+
+// Read a text or binary complex file, whichever it is: mapped if
+// it is a regular file, read() into a buffer otherwise.
+// Prints the usual error and returns empty if it cannot be opened.
+inline std::vector<std::complex<double>> ReadComplexFile(const std::string& filename)
+{
+    MappedFile file(filename);
+    if(file.IsOpen()) return ParseComplexData(file.Data(), file.Size());
+
+    // an existing empty file is just empty
+    std::vector<char> buffer;
+    if(!ReadWholeFile(filename, buffer))
+    {
+        std::cerr << "Error opening file " << filename << std::endl;
+        return {};
+    }
+    return ParseComplexData(buffer.data(), buffer.size());
+}
+
+// Write values as a binary .cvec file, "-" for stdout.
+// Returns false on I/O error.
+inline bool WriteComplexBinary(const std::string& filename,
+    const std::complex<double>* values, size_t count)
+{
+    bool toStdout = (filename == "-");
+    std::FILE* file = toStdout ? stdout : std::fopen(filename.c_str(), "wb");
+    if(!file) return false;
+    if(toStdout) std::cout.flush();
+    ComplexFileHeader header;
+    std::memcpy(header.magic, complexFileMagic, 4);
+    header.version = complexFileVersion;
+    header.count = count;
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1
+        && std::fwrite(values, sizeof(std::complex<double>), count, file) == count;
+    if(toStdout) return std::fflush(file) == 0 && ok;
+    return std::fclose(file) == 0 && ok;
+}
+
+/*
+    Buffered text output for spectra.
+        Plain()      "re im"   same as  out << re << " " << im
+                     (default stream format, 6 significant digits)
+        Formatted()  "a+bi"    same as PrintFormattedVector: whole
+                     numbers as ints, anything else fixed to 3 places
+    Both end the line with '\n'. The buffer is flushed when full
+    and on destruction, so output stays in order with anything
+    written to the stream before the writer was made.
+*/
+class ComplexWriter
+{
+public:
+    ComplexWriter(std::ostream& _out = std::cout)
+    : out_(_out), used_(0)
+    {}
+    ~ComplexWriter() { Flush(); }
+    ComplexWriter(const ComplexWriter&) = delete;
+    ComplexWriter& operator=(const ComplexWriter&) = delete;
+
+    void Plain(const std::complex<double>& value)
+    {
+        Reserve();
+        General(value.real());
+        buffer_[used_++] = ' ';
+        General(value.imag());
+        buffer_[used_++] = '\n';
+    }
+
+    void Formatted(const std::complex<double>& value)
+    {
+        Reserve();
+        Fixed(value.real());
+        if(value.imag() >= 0) buffer_[used_++] = '+';
+        Fixed(value.imag());
+        buffer_[used_++] = 'i';
+        buffer_[used_++] = '\n';
+    }
+
+    void Flush()
+    {
+        if(used_ == 0) return;
+        out_.write(buffer_, used_);
+        out_.flush();
+        used_ = 0;
+    }
+
+private:
+    // room for two fixed-point doubles (up to ~310 digits each)
+    static const size_t lineMax = 1024;
+    static const size_t bufferSize = 1 << 16;
+
+    void Reserve()
+    {
+        if(used_ + lineMax > bufferSize) Flush();
+    }
+    void General(double value)
+    {
+        auto result = std::to_chars(buffer_ + used_, buffer_ + bufferSize,
+            value, std::chars_format::general, 6);
+        used_ = result.ptr - buffer_;
+    }
+    void Fixed(double value)
+    {
+        std::to_chars_result result;
+        if(value == (int)value)
+        {
+            result = std::to_chars(buffer_ + used_, buffer_ + bufferSize, (int)value);
+        } else {
+            result = std::to_chars(buffer_ + used_, buffer_ + bufferSize,
+                value, std::chars_format::fixed, 3);
+        }
+        used_ = result.ptr - buffer_;
+    }
+
+    std::ostream& out_;
+    char buffer_[bufferSize];
+    size_t used_;
+};
+
+#endif // COMPLEX_IO_H
@@ -0,0 +1,139 @@
+#ifndef GOERTZEL_H
+#define GOERTZEL_H
+
+/*
+    Goertzel evaluation of one or a few frequency bins.
+
+    For a frame x[0..N-1] and a frequency ω (radians per sample,
+    2πk/N for DFT bin k) the recurrence
+        s[n] = x[n] + 2cos(ω) s[n-1] - s[n-2]        (s[-1] = s[-2] = 0)
+    run one step past the end (x[N] = 0) gives
+        s[N] - e^(-iω) s[N-1] = Σ x[n] e^(iω(N-n)) = e^(iωN) X(ω)
+    so
+        X(ω) = Σ x[n] e^(-iωn) = e^(-iωN) (s[N] - e^(-iω) s[N-1])
+    One multiply and two adds per sample, no cos/sin in the loop:
+    2cos(ω), e^(-iω) and e^(-iωN) are worked out once per bin when
+    the evaluator is made. For a whole bin k, e^(-iωN) = 1.
+
+    Real frames run the recurrence on doubles (half the work of a
+    complex frame); a window, if given, is applied sample by sample
+    on the way in, so frames are read in place and never copied.
+    Rounding error grows with N and is worst near ω = 0 and π; the
+    state is always double so 16-bit and float frames of a few
+    thousand samples stay well inside float precision.
+*/
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace goertzel
+{
+    template<typename T> struct IsComplex : std::false_type {};
+    template<typename T> struct IsComplex<std::complex<T>> : std::true_type {};
+
+    // complex<double> state for complex frames, double otherwise
+    template<typename Sample>
+    using State = typename std::conditional<IsComplex<Sample>::value,
+        std::complex<double>, double>::type;
+
+    inline std::complex<double> Widen(const std::complex<double>& value) { return value; }
+    inline std::complex<double> Widen(const std::complex<float>& value)
+    {
+        return std::complex<double>(value.real(), value.imag());
+    }
+    template<typename T> double Widen(T value) { return static_cast<double>(value); }
+}
+
+class Goertzel
+{
+public:
+    // Frequency of DFT bin k for an N-sample frame
+    static double BinFrequency(double k, size_t N)
+    {
+        return 2.0 * M_PI * k / static_cast<double>(N);
+    }
+
+    // One bin
+    Goertzel(double _omega, size_t _length)
+    : Goertzel(std::vector<double>(1, _omega), _length)
+    {}
+
+    // A few bins over frames of _length samples
+    Goertzel(const std::vector<double>& _omegas, size_t _length)
+    : length_(_length)
+    {
+        for(double omega : _omegas)
+        {
+            coefficients_.push_back(2.0 * std::cos(omega));
+            closing_.push_back(std::polar(1.0, -omega));
+            double turns = omega * static_cast<double>(_length);
+            phase_.push_back(std::polar(1.0, -turns));
+        }
+    }
+
+    size_t Length() const { return length_; }
+    size_t Bins() const { return coefficients_.size(); }
+
+    // X(ω_b) for every bin b into bins[0..Bins()-1]. frame holds
+    // Length() samples (short, float, double or complex); window,
+    // if not null, holds Length() weights.
+    template<typename Sample, typename Weight = double>
+    void Execute(const Sample* frame, std::complex<double>* bins,
+        const Weight* window = nullptr) const
+    {
+        for(size_t b = 0; b < coefficients_.size(); ++b)
+        {
+            bins[b] = Evaluate(frame, window, b);
+        }
+    }
+
+    // Single-bin shorthand for bin b
+    template<typename Sample, typename Weight = double>
+    std::complex<double> Bin(const Sample* frame, const Weight* window = nullptr,
+        size_t b = 0) const
+    {
+        return Evaluate(frame, window, b);
+    }
+
+private:
+    template<typename Sample, typename Weight>
+    std::complex<double> Evaluate(const Sample* frame, const Weight* window, size_t b) const
+    {
+        using State = goertzel::State<Sample>;
+        const double coefficient = coefficients_[b];
+        State s1 = 0.0, s2 = 0.0;
+        if(window)
+        {
+            for(size_t n = 0; n < length_; ++n)
+            {
+                State s0 = goertzel::Widen(frame[n]) * static_cast<double>(window[n])
+                    + coefficient * s1 - s2;
+                s2 = s1;
+                s1 = s0;
+            }
+        } else {
+            for(size_t n = 0; n < length_; ++n)
+            {
+                State s0 = goertzel::Widen(frame[n]) + coefficient * s1 - s2;
+                s2 = s1;
+                s1 = s0;
+            }
+        }
+        // the extra step with x[N] = 0
+        State sN = coefficient * s1 - s2;
+        return phase_[b] * (std::complex<double>(sN) - closing_[b] * std::complex<double>(s1));
+    }
+
+    size_t length_;
+    // 2cos(ω)
+    std::vector<double> coefficients_;
+    // e^(-iω)
+    std::vector<std::complex<double>> closing_;
+    // e^(-iωN)
+    std::vector<std::complex<double>> phase_;
+};
+
+#endif // GOERTZEL_H
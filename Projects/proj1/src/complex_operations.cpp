@@ -3,28 +3,8 @@
 
 comVec Read(string filename)
 {
-    string line;
-    comVec numbers;
-    std::ifstream file(filename);
-    if(!file.is_open()){
-        std::cerr << "Error opening file " << filename << std::endl;
-        return numbers;
-    }
-    while(std::getline(file, line))
-    {
-        complex num;
-        double real, imag;
-        char plus, i;
-        std::istringstream stream(line);
-        if(stream >> real >> plus >> imag >> i){
-            double imagFinal = (plus == '-') ? -imag : imag;
-            num = complex(real, imagFinal);
-            numbers.emplace_back(num);
-            // std::cout << "Read from " << filename << " "
-            // << num << std::endl;
-        }
-    }
-    return numbers;
+    // text or .cvec binary, see common/complex_io.h
+    return ReadComplexFile(filename);
 }
 // Rotate ///////////////////////////////////////////////////////////////
 void Rotate::execute(){
@@ -135,13 +115,20 @@ void InnerUnity::makeUnityVec(){
     }
 }
 
-void InnerUnity::execute(){
-    makeUnityVec();
-    InnerProd inner(N_, vec1_, unity_);
-    inner.execute();
-    result_ = inner.result();
-
-
+// <vec, unity> = Σ vec[i] e^(-2πi i/N), DFT bin 1 of vec.
+// Goertzel recurrence straight over vec1_, no unity_ vector
+// and no cos/sin per element (see common/goertzel.h)
+bool InnerUnity::execute(){
+    // Goertzel takes N as size_t: 0 would divide by zero and a
+    // negative N would loop about 2^64 times
+    if(N_ <= 0 || vec1_.size() < static_cast<size_t>(N_))
+    {
+        std::cerr << "Error: Expected " << N_ << " complex numbers (N > 0), got " << vec1_.size() << std::endl;
+        return false;
+    }
+    Goertzel bin(Goertzel::BinFrequency(1, N_), N_);
+    result_ = bin.Bin(vec1_.data());
+    return true;
 }
 
 void InnerUnity::print(){
@@ -154,6 +141,7 @@ void InnerUnity::print(){
 
 void InnerUnity::DebugPrint()
 {
+    if(unity_.empty()) makeUnityVec();
     std::cout << "Input Vec: ";
     for(int i = 0; i < N_; ++i)
     {
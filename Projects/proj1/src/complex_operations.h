@@ -4,6 +4,8 @@
 #include <vector>
 #include <cmath>
 #include <iomanip>
+#include "complex_io.h"
+#include "goertzel.h"
 using string = std::string;
 using comVec = std::vector<std::complex<double>>; 
 using complex = std::complex<double>;
@@ -81,7 +83,9 @@ public:
     : N_(_N), vec1_(_vec) {}
 
     void makeUnityVec();
-    void execute();
+    // false, with an error printed, if N <= 0 or the file held
+    // fewer than N values
+    bool execute();
     void print();
     void DebugPrint();
 private:    
@@ -57,7 +57,7 @@ int main(int argc, char *argv[])
         }break;
         case(4):{
             InnerUnity unity( atoi(argv[1+arg_offset]), Read(argv[2+arg_offset]));
-            unity.execute();
+            if(!unity.execute()) return 1;
             unity.print();
         }break;
         default: return 0;
@@ -2,26 +2,7 @@
 
 void DFT::Read()
 {
-    string line;
-    std::ifstream file(filename_);
-    if(!file.is_open()){
-        std::cerr << "Error opening file " << filename_ << std::endl;
-        return;
-    }
-    while(std::getline(file, line))
-    {
-        complex num;
-        double real, imag;
-        char plus, i;
-        std::istringstream stream(line);
-        if(stream >> real >> plus >> imag >> i){
-            double imagFinal = (plus == '-') ? -imag : imag;
-            num = complex(real, imagFinal);
-            numbers_.emplace_back(num);
-            // std::cout << "Read from " << filename << " "
-            // << num << std::endl;
-        }
-    }
+    numbers_ = ReadComplexFile(filename_);
 }
 // Converts sequence of complex numbers from time domain to 
 //      the frequency domain. 
@@ -44,6 +25,59 @@ void DFT::Execute()
     }
 }
 
+bool DFT::ExecuteTable(unsigned _threads)
+{
+    // every worker reads all N inputs: check they are there first
+    if(size_ <= 0 || numbers_.size() < static_cast<size_t>(size_))
+    {
+        std::cerr << "Error: Expected " << size_ << " complex numbers, got " << numbers_.size() << std::endl;
+        return false;
+    }
+    const unsigned N = size_;
+    // W_N^j for j < N; W^(kn) = W^((kn) mod N)
+    std::vector<double> twiddleRe(N), twiddleIm(N);
+    for(unsigned j = 0; j < N; ++j)
+    {
+        double angle = -2.0 * M_PI * j / N;
+        twiddleRe[j] = cos(angle);
+        twiddleIm[j] = sin(angle);
+    }
+    result_.assign(N, complex(0, 0));
+
+    // frequency bins [begin, end)
+    auto bins = [&](unsigned begin, unsigned end)
+    {
+        for(unsigned k = begin; k < end; ++k)
+        {
+            double re = 0.0, im = 0.0;
+            // index = (k*n) mod N stepped by k; the wrap is a mask
+            // since a branch would mispredict about half the time
+            unsigned index = 0;
+            for(unsigned n = 0; n < N; ++n)
+            {
+                double xr = numbers_[n].real(), xi = numbers_[n].imag();
+                re += xr * twiddleRe[index] - xi * twiddleIm[index];
+                im += xr * twiddleIm[index] + xi * twiddleRe[index];
+                index += k;
+                index -= N & (0u - static_cast<unsigned>(index >= N));
+            }
+            result_[k] = complex(re, im);
+        }
+    };
+
+    unsigned threads = _threads ? _threads : std::thread::hardware_concurrency();
+    if(threads == 0) threads = 1;
+    if(threads > N) threads = N ? N : 1;
+    std::vector<std::thread> workers;
+    for(unsigned t = 1; t < threads; ++t)
+    {
+        workers.emplace_back(bins, N * t / threads, N * (t + 1) / threads);
+    }
+    bins(0, N / threads);
+    for(auto& worker : workers) worker.join();
+    return true;
+}
+
 void DFT::Print()
 {
     PrintFormattedVector(result_);
@@ -60,32 +94,11 @@ void DFT::Print()
     
 }
 
-void PrintFormattedVector(CVector input)
+void PrintFormattedVector(const CVector& input)
 {
-    for(auto num: input)
+    ComplexWriter writer;
+    for(const auto& num: input)
     {
-        double real = num.real();
-        double imag = num.imag();
-        if(real == (int)real)
-        {
-            std::cout << std::fixed << std::setprecision(0)
-            << (int)real;
-        } else {
-            std::cout << std::fixed << std::setprecision(3) << real;
-        }
-        if(imag >= 0)
-        {
-            //std::setprecision(0);
-            std::cout << "+";
-        } 
-        if(imag == (int)imag)
-        {
-            std::cout << std::fixed << std::setprecision(0)
-            <<  (int)imag;
-        } else {
-            std::cout << std::fixed << std::setprecision(3) << imag;
-        }
-        
-        std::cout << "i" << std::endl;
+        writer.Formatted(num);
     }
 }
\ No newline at end of file
@@ -8,12 +8,14 @@
 #include <fstream>
 #include <sstream>
 #include <cmath>
+#include <thread>
+#include "complex_io.h"
 
 using complex = std::complex<double>;
 using string = std::string;
 using CVector = std::vector<complex>;
 
-void PrintFormattedVector(CVector input);
+void PrintFormattedVector(const CVector& input);
 
 class DFT{
 public:
@@ -23,6 +25,12 @@ public:
     {}
     void Read();
     void Execute();
+    // Same transform for large N: twiddles come from one N-entry
+    // table indexed by (k*n) mod N, and the frequency bins are split
+    // into contiguous blocks across threads (0 = every core).
+    // False, with an error printed, if N is not positive or the
+    // file held fewer than N values
+    bool ExecuteTable(unsigned _threads = 0);
     void Print();
 
     string filename_;
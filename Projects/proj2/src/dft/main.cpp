@@ -14,6 +14,7 @@ int main(int argc, char*argv[])
 {
     if(argc < 3){
         std::cerr << "Not enough arguments" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <input_file> <N> [table [threads]]" << std::endl;
         return 1;
     }
     //std::cout << argv[1] << " " << atoi(argv[2]) << std::endl;
@@ -21,7 +22,13 @@ int main(int argc, char*argv[])
     fourier.Read();
     //std::cout << fourier.numbers_.size() << std::endl;
     //PrintFormattedVector(fourier.numbers_);
-    fourier.Execute();
+    // "table": twiddle table and threads, for N in the tens of thousands
+    if(argc > 3 && std::string(argv[3]) == "table")
+    {
+        if(!fourier.ExecuteTable(argc > 4 ? atoi(argv[4]) : 0)) return 1;
+    } else {
+        fourier.Execute();
+    }
     fourier.Print();
     return 0;
 }
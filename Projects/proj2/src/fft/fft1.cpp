@@ -35,29 +35,45 @@ CVector FFT::Execute(CVector input)
     return result;
 }
 
-void FFT::Read()
+/*
+    Strided recursion: the even and odd halves are never copied out.
+    The even samples of a stride-s view are a stride-2s view of the
+    same buffer starting at 0, the odd ones start at s. Each half
+    writes its DFT into its half of output, and the butterflies
+    then combine them in place, with the same twiddle and the same
+    operation order as Execute(CVector), so the results are
+    bit-for-bit identical.
+*/
+void FFT::ExecuteStrided(const complex* input, complex* output, int N, int stride)
 {
-    string line;
-    std::ifstream file(filename_);
-    if(!file.is_open()){
-        std::cerr << "Error opening file " << filename_ << std::endl;
+    if(N == 1) {
+        output[0] = input[0];
         return;
     }
-    while(std::getline(file, line))
-    {
-        complex num;
-        double real, imag;
-        char plus, i;
-        std::istringstream stream(line);
-        if(stream >> real >> plus >> imag >> i){
-            double imagFinal = (plus == '-') ? -imag : imag;
-            num = complex(real, imagFinal);
-            numbers_.emplace_back(num);
-            // std::cout << "Read from " << filename << " "
-            // << num << std::endl;
-        }
+    int half = N / 2;
+    ExecuteStrided(input, output, half, 2 * stride);
+    ExecuteStrided(input + stride, output + half, half, 2 * stride);
+
+    for(int k = 0; k < half; ++k) {
+        double angle = -2.0 * M_PI * k / N;
+        complex twiddle(cos(angle), sin(angle));
+        complex t = twiddle * output[k + half];
+        complex even = output[k];
+
+        output[k] = even + t;
+        output[k + half] = even - t;
     }
+}
 
+void FFT::Execute(const CVector& input, CVector& output)
+{
+    output.resize(input.size());
+    ExecuteStrided(input.data(), output.data(), static_cast<int>(input.size()), 1);
+}
+
+void FFT::Read()
+{
+    numbers_ = ReadComplexFile(filename_);
 }
 
 void FFT::Print()
@@ -65,32 +81,11 @@ void FFT::Print()
     PrintFormattedVector(result_);
 }
 
-void PrintFormattedVector(CVector input)
+void PrintFormattedVector(const CVector& input)
 {
-    for(auto num: input)
+    ComplexWriter writer;
+    for(const auto& num: input)
     {
-        double real = num.real();
-        double imag = num.imag();
-        if(real == (int)real)
-        {
-            std::cout << std::fixed << std::setprecision(0)
-            << (int)real;
-        } else {
-            std::cout << std::fixed << std::setprecision(3) << real;
-        }
-        if(imag >= 0)
-        {
-            //std::setprecision(0);
-            std::cout << "+";
-        } 
-        if(imag == (int)imag)
-        {
-            std::cout << std::fixed << std::setprecision(0)
-            <<  (int)imag;
-        } else {
-            std::cout << std::fixed << std::setprecision(3) << imag;
-        }
-        
-        std::cout << "i" << std::endl;
+        writer.Formatted(num);
     }
 }
\ No newline at end of file
@@ -7,12 +7,13 @@
 #include <fstream>
 #include <sstream>
 #include <cmath>
+#include "complex_io.h"
 
 using complex = std::complex<double>;
 using string = std::string;
 using CVector = std::vector<complex>;
 
-void PrintFormattedVector(CVector input);
+void PrintFormattedVector(const CVector& input);
 
 class FFT
 {
@@ -29,6 +30,9 @@ public:
     // X[k + N/2] = E[k] - W_N^k * O[k]
         // W_N^(k + N/2) = W_N^k * W_N^(N/2) = W_N^k * (-1) = -W_N^k
     CVector Execute(CVector input);
+    // Same result as Execute, without allocating once output
+    // holds input.size() values (it is resized to that)
+    void Execute(const CVector& input, CVector& output);
     void Print();
 
 
@@ -37,4 +41,9 @@ public:
     int size_;
     CVector numbers_;
     CVector result_;
+
+private:
+    // N-point FFT of input[0], input[stride], input[2*stride], ...
+    // written contiguously to output[0..N-1]
+    void ExecuteStrided(const complex* input, complex* output, int N, int stride);
 };
\ No newline at end of file
@@ -9,7 +9,8 @@ int main(int argc, char *argv[])
     FFT fourier(argv[1], atoi(argv[2]));
     fourier.Read();
     //PrintFormattedVector(fourier.numbers_);
-    fourier.result_ = fourier.Execute(fourier.numbers_);
+    fourier.result_.resize(fourier.numbers_.size());
+    fourier.Execute(fourier.numbers_, fourier.result_);
     fourier.Print();
 
     return 0;
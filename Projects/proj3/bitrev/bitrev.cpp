@@ -1,28 +1,14 @@
 #include "bitrev.h"
-#include "../timing.h"
 #include <iostream>
 #include <string>
 #include <cstdlib>
 
 
 // Input from binary string conversion
+// Byte lookup table instead of testing one bit at a time (permute.h)
 u_int bitReverse(u_int input, u_int numBits) 
 {
-    u_int reversed = 0;
-    u_int last = numBits - 1;
-    for(u_int bit = 0; bit < numBits; ++bit)
-    {
-        // checking for set bits
-        // left shift -> place 1 in specified position by 'bit'
-        // & mask -> if AND, is set. 
-        if( input & (1 << bit))
-        {
-            // bitwise OR. Sets bit if confirmed set. 
-            // Left shift, sets one opposite input bit.
-            reversed |= (1 << (last - bit));
-        }
-    }
-    return reversed;
+    return ReverseBits(input, numBits);
 }
 
 u_vector toBinary(u_int n, u_int numBits) 
@@ -1,7 +1,7 @@
 #ifndef BITREV_H
 #define BITREV_H
 
-#include "../timing.h"
+#include "permute.h"
 
 
 //#include <string>
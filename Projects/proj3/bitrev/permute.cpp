@@ -0,0 +1,142 @@
+#include "permute.h"
+#include <utility>
+
+namespace
+{
+    // Reversed value of every byte, built at compile time
+    struct ByteTable
+    {
+        unsigned char table[256];
+        constexpr ByteTable() : table()
+        {
+            for(u_int i = 0; i < 256; ++i)
+            {
+                u_int reversed = 0;
+                for(u_int bit = 0; bit < 8; ++bit)
+                {
+                    if(i & (1u << bit)) reversed |= (1u << (7 - bit));
+                }
+                table[i] = static_cast<unsigned char>(reversed);
+            }
+        }
+    };
+    constexpr ByteTable byteTable;
+
+    // Use the blocked path once the array no longer fits in cache
+    // (2^16 complex doubles = 1 MB).
+    const u_int blockedMinBits = 16;
+    // 2^5 x 2^5 tile of complex doubles = 16 KB per buffer
+    const u_int tileBits = 5;
+}
+
+u_int ReverseBits(u_int input, u_int numBits)
+{
+    if(numBits == 0) return 0;
+    // reverse all 32 bits byte by byte, then drop the unused low end
+    u_int reversed =
+        (static_cast<u_int>(byteTable.table[input & 0xff]) << 24) |
+        (static_cast<u_int>(byteTable.table[(input >> 8) & 0xff]) << 16) |
+        (static_cast<u_int>(byteTable.table[(input >> 16) & 0xff]) << 8) |
+        (static_cast<u_int>(byteTable.table[(input >> 24) & 0xff]));
+    return reversed >> (32 - numBits);
+}
+
+BitReversal::BitReversal(u_int _size)
+: size_(_size), numBits_(0), blockBits_(0)
+{
+    // log2(N)
+    for(u_int n = size_; n > 1; n >>= 1) ++numBits_;
+
+    if(numBits_ >= blockedMinBits)
+    {
+        blockBits_ = tileBits;
+        u_int tileSide = 1u << blockBits_;
+        blockReversed_.resize(tileSide);
+        for(u_int a = 0; a < tileSide; ++a)
+        {
+            blockReversed_[a] = ReverseBits(a, blockBits_);
+        }
+    }
+}
+
+void BitReversal::Execute(complex* data) const
+{
+    if(Blocked()) ExecuteCOBRA(data);
+    else ExecuteLUT(data);
+}
+
+void BitReversal::Execute(double* data) const
+{
+    if(Blocked()) ExecuteCOBRA(data);
+    else ExecuteLUT(data);
+}
+
+void BitReversal::Execute(f_complex* data) const
+{
+    if(Blocked()) ExecuteCOBRA(data);
+    else ExecuteLUT(data);
+}
+
+template<typename T>
+void BitReversal::ExecuteLUT(T* data) const
+{
+    for(u_int i = 0; i < size_; ++i)
+    {
+        u_int reversed = ReverseBits(i, numBits_);
+        // only swap if lower index (crossover)
+        if(i < reversed) std::swap(data[i], data[reversed]);
+    }
+}
+
+template<typename T>
+void BitReversal::ExecuteCOBRA(T* data) const
+{
+    const u_int b = blockBits_;
+    const u_int side = 1u << b;
+    // bits between the two tile halves
+    const u_int midBits = numBits_ - 2 * b;
+    const u_int midCount = 1u << midBits;
+    // index = a << aShift | c << b | d
+    const u_int aShift = midBits + b;
+    std::vector<T> tile(side * side);
+    std::vector<T> tilePair(side * side);
+
+    for(u_int c = 0; c < midCount; ++c)
+    {
+        u_int cRev = ReverseBits(c, midBits);
+        // each pair of tiles is handled once, from its lower side
+        if(cRev < c) continue;
+
+        // gather: tile[rev(a)][d] = x[a | c | d]
+        for(u_int a = 0; a < side; ++a)
+        {
+            const T* src = data + ((a << aShift) | (c << b));
+            T* row = tile.data() + (blockReversed_[a] << b);
+            for(u_int d = 0; d < side; ++d) row[d] = src[d];
+        }
+        if(cRev != c)
+        {
+            for(u_int a = 0; a < side; ++a)
+            {
+                const T* src = data + ((a << aShift) | (cRev << b));
+                T* row = tilePair.data() + (blockReversed_[a] << b);
+                for(u_int d = 0; d < side; ++d) row[d] = src[d];
+            }
+        }
+
+        // scatter: x[rev(d) | rev(c) | rev(a)] = tile[rev(a)][d]
+        for(u_int d = 0; d < side; ++d)
+        {
+            T* dst = data + ((blockReversed_[d] << aShift) | (cRev << b));
+            for(u_int ra = 0; ra < side; ++ra) dst[ra] = tile[(ra << b) | d];
+        }
+        if(cRev != c)
+        {
+            for(u_int d = 0; d < side; ++d)
+            {
+                T* dst = data + ((blockReversed_[d] << aShift) | (c << b));
+                for(u_int ra = 0; ra < side; ++ra) dst[ra] = tilePair[(ra << b) | d];
+            }
+        }
+    }
+}
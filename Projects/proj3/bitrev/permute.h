@@ -0,0 +1,57 @@
+#ifndef PERMUTE_H
+#define PERMUTE_H
+
+#include <complex>
+using complex = std::complex<double>;
+#include <vector>
+using c_vector = std::vector<complex>;
+// single precision, for the float transforms
+using f_complex = std::complex<float>;
+using f_vector = std::vector<f_complex>;
+using u_int = unsigned int;
+using u_vector = std::vector<unsigned int>;
+
+// Reverse the low numBits bits of input, one byte at a time
+// through a 256-entry lookup table instead of bit by bit.
+u_int ReverseBits(u_int input, u_int numBits);
+
+/*
+    Bit-reversal permutation, x[i] <-> x[bitReverse(i)].
+
+    Small N: walk i and swap with its reverse (byte LUT).
+        The whole array sits in cache, so the random access is cheap.
+    Large N: COBRA (Carter & Gatlin), cache-blocked.
+        Split each index into  a | c | d  with a and d blockBits_ wide.
+        bitReverse(a|c|d) = rev(d) | rev(c) | rev(a), so the
+        2^b x 2^b tile with middle bits c maps onto the tile
+        with middle bits rev(c), transposed. Both tiles are
+        copied into a small buffer and written back a row at a
+        time, so every memory touch is a contiguous run of 2^b.
+*/
+class BitReversal
+{
+public:
+    BitReversal(u_int _size);
+
+    void Execute(complex* data) const;
+    void Execute(c_vector& data) const { Execute(data.data()); }
+    // split real/imag layout, one array at a time
+    void Execute(double* data) const;
+    // single-precision transforms (BasicFFTPlan<float>)
+    void Execute(f_complex* data) const;
+
+    bool Blocked() const { return blockBits_ > 0; }
+
+private:
+    template<typename T> void ExecuteLUT(T* data) const;
+    template<typename T> void ExecuteCOBRA(T* data) const;
+
+    u_int size_;
+    u_int numBits_;
+    // 0 -> LUT path
+    u_int blockBits_;
+    // rev(a) for a in [0, 2^blockBits_)
+    u_vector blockReversed_;
+};
+
+#endif // PERMUTE_H
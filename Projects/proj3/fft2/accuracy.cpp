@@ -0,0 +1,229 @@
+#include "accuracy.h"
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <random>
+
+namespace
+{
+    using l_complex = std::complex<long double>;
+    using l_vector = std::vector<l_complex>;
+
+    const u_int signalCount = 4;
+    const char* signalNames[signalCount] = {"random", "impulse", "tone", "chirp"};
+
+    // non powers of two: 7-smooth mixed radix, then Bluestein sizes
+    const u_int otherSizes[] = {12, 100, 1000, 97, 1009, 4095};
+
+    bool IsPowerTwo(u_int N) { return N != 0 && (N & (N - 1)) == 0; }
+
+    c_vector MakeSignal(u_int which, u_int N, bool realInput)
+    {
+        c_vector signal(N);
+        std::mt19937 random(320 + N);
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        for(u_int n = 0; n < N; ++n)
+        {
+            double phase;
+            switch(which)
+            {
+            case 0:
+                signal[n] = complex(uniform(random), uniform(random));
+                break;
+            case 1:
+                signal[n] = (n == 1) ? 1.0 : 0.0;
+                break;
+            case 2:
+                phase = 2.0 * M_PI * ((3ull * n) % N) / N;
+                signal[n] = complex(cos(phase), sin(phase));
+                break;
+            default:
+                // frequency sweeps 0 .. N/2 across the signal
+                phase = M_PI * n * (static_cast<double>(n) / (2.0 * N));
+                signal[n] = complex(cos(phase), sin(phase));
+                break;
+            }
+            if(realInput) signal[n] = signal[n].real();
+        }
+        return signal;
+    }
+
+    l_vector ReferenceDFT(const c_vector& input)
+    {
+        u_int N = static_cast<u_int>(input.size());
+        l_vector twiddles(N);
+        for(u_int j = 0; j < N; ++j)
+        {
+            long double angle = -2.0L * 3.141592653589793238462643383279502884L * j / N;
+            twiddles[j] = l_complex(cosl(angle), sinl(angle));
+        }
+        l_vector output(N);
+        for(u_int k = 0; k < N; ++k)
+        {
+            l_complex sum = 0.0L;
+            unsigned long long index = 0;
+            for(u_int n = 0; n < N; ++n)
+            {
+                sum += l_complex(input[n].real(), input[n].imag()) * twiddles[index];
+                index += k;
+                if(index >= N) index -= N;
+            }
+            output[k] = sum;
+        }
+        return output;
+    }
+
+    // relative max and rms of result against reference
+    void Compare(const c_vector& result, const l_vector& reference,
+        double& maxError, double& rmsError)
+    {
+        long double peak = 0.0L, diffMax = 0.0L, diffSum = 0.0L, refSum = 0.0L;
+        for(size_t k = 0; k < result.size(); ++k)
+        {
+            l_complex diff = l_complex(result[k].real(), result[k].imag()) - reference[k];
+            long double magnitude = std::abs(reference[k]);
+            peak = std::max(peak, magnitude);
+            diffMax = std::max(diffMax, std::abs(diff));
+            diffSum += std::norm(diff);
+            refSum += magnitude * magnitude;
+        }
+        maxError = peak > 0.0L ? static_cast<double>(diffMax / peak) : 0.0;
+        rmsError = refSum > 0.0L ? static_cast<double>(sqrtl(diffSum / refSum)) : 0.0;
+    }
+}
+
+AccuracyCheck::AccuracyCheck(u_int _maxLog2)
+: maxLog2_(_maxLog2)
+{}
+
+void AccuracyCheck::Add(const std::string& name, AccuracySetup setup,
+    bool anySize, bool realInput, u_int maxSize, double epsilon)
+{
+    kernels_.push_back({name, setup, anySize, realInput, maxSize, epsilon});
+}
+
+AccuracyResult AccuracyCheck::Check(const AccuracyKernel& kernel, u_int size) const
+{
+    AccuracyTransform transform = kernel.setup(size);
+
+    AccuracyResult result;
+    result.kernel = kernel.name;
+    result.size = size;
+    result.roundTrip = size > referenceMaxSize;
+    result.maxError = 0.0;
+    result.rmsError = 0.0;
+    result.epsilon = kernel.epsilon;
+
+    for(u_int which = 0; which < signalCount; ++which)
+    {
+        c_vector signal = MakeSignal(which, size, kernel.realInput);
+        c_vector data = signal;
+        transform.forward(data.data());
+
+        l_vector reference;
+        if(!result.roundTrip)
+        {
+            reference = ReferenceDFT(signal);
+        } else {
+            if(transform.inverse)
+            {
+                transform.inverse(data.data());
+            } else {
+                // conj(F(conj(X))) / N
+                for(auto& value : data) value = std::conj(value);
+                transform.forward(data.data());
+                double scale = 1.0 / size;
+                for(auto& value : data) value = std::conj(value) * scale;
+            }
+            reference.resize(size);
+            for(u_int n = 0; n < size; ++n)
+            {
+                reference[n] = l_complex(signal[n].real(), signal[n].imag());
+            }
+        }
+
+        double maxError, rmsError;
+        Compare(data, reference, maxError, rmsError);
+        result.maxError = std::max(result.maxError, maxError);
+        result.rmsError = std::max(result.rmsError, rmsError);
+    }
+
+    double log2N = std::max(1.0, std::log2(static_cast<double>(size)));
+    result.flagged = result.rmsError > 2.0 * kernel.epsilon * log2N
+        || result.maxError > 8.0 * kernel.epsilon * log2N;
+    result.best = 1.0;
+    return result;
+}
+
+u_int AccuracyCheck::CheckPermutation(u_int size) const
+{
+    u_int numBits = 0;
+    while((1u << numBits) < size) ++numBits;
+    c_vector data(size);
+    for(u_int i = 0; i < size; ++i) data[i] = complex(i, 0.0);
+    BitReversal(size).Execute(data);
+    u_int wrong = 0;
+    for(u_int i = 0; i < size; ++i)
+    {
+        if(data[i].real() != ReverseBits(i, numBits)) ++wrong;
+    }
+    return wrong;
+}
+
+u_int AccuracyCheck::Run(std::ostream& log)
+{
+    std::vector<u_int> sizes;
+    for(u_int log2 = 1; log2 <= maxLog2_; ++log2) sizes.push_back(1u << log2);
+    for(u_int N : otherSizes) sizes.push_back(N);
+
+    // wide enough for the longest name plus a space
+    size_t nameWidth = 18;
+    for(const auto& kernel : kernels_) nameWidth = std::max(nameWidth, kernel.name.size() + 1);
+
+    log << "signals:";
+    for(u_int which = 0; which < signalCount; ++which) log << " " << signalNames[which];
+    log << "\n" << std::left << std::setw(nameWidth) << "kernel" << std::right
+    << std::setw(10) << "N" << std::setw(13) << "reference" << std::setw(12) << "max"
+    << std::setw(12) << "rms" << std::setw(9) << "x best" << "  status" << std::endl;
+
+    u_int flagged = 0;
+    for(u_int N : sizes)
+    {
+        size_t first = results_.size();
+        for(const auto& kernel : kernels_)
+        {
+            if(!kernel.anySize && !IsPowerTwo(N)) continue;
+            if(kernel.maxSize != 0 && N > kernel.maxSize) continue;
+            results_.push_back(Check(kernel, N));
+        }
+        for(size_t i = first; i < results_.size(); ++i)
+        {
+            AccuracyResult& result = results_[i];
+            double lowest = std::numeric_limits<double>::max();
+            for(size_t j = first; j < results_.size(); ++j)
+            {
+                if(results_[j].epsilon == result.epsilon) lowest = std::min(lowest, results_[j].rmsError);
+            }
+            result.best = lowest > 0.0 ? result.rmsError / lowest : 1.0;
+            if(result.flagged) ++flagged;
+            log << std::left << std::setw(nameWidth) << result.kernel << std::right
+            << std::setw(10) << N << std::setw(13) << (result.roundTrip ? "roundtrip" : "dft")
+            << std::scientific << std::setprecision(2)
+            << std::setw(12) << result.maxError << std::setw(12) << result.rmsError
+            << std::fixed << std::setprecision(1) << std::setw(9) << result.best
+            << (result.flagged ? "  REGRESSION" : "  ok") << std::endl;
+        }
+
+        if(IsPowerTwo(N))
+        {
+            u_int wrong = CheckPermutation(N);
+            if(wrong) ++flagged;
+            log << std::left << std::setw(nameWidth) << "bitrev" << std::right
+            << std::setw(10) << N << std::setw(13) << "ReverseBits"
+            << std::setw(33) << (wrong ? std::to_string(wrong) + " wrong" : std::string("exact"))
+            << (wrong ? "  REGRESSION" : "  ok") << std::endl;
+        }
+    }
+    log << (flagged ? std::to_string(flagged) + " flagged" : std::string("all within bounds")) << std::endl;
+    return flagged;
+}
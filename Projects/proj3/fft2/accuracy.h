@@ -0,0 +1,106 @@
+#ifndef ACCURACY_H
+#define ACCURACY_H
+
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "plan.h"
+
+/*
+    Native accuracy check for every transform, at any N.
+    Signals: random (uniform in the unit square), impulse at n = 1,
+    tone (e^(2πi 3n/N), one bin), linear chirp.
+
+    Two references:
+        dft         N <= referenceMaxSize: direct DFT in long double,
+                    twiddles W^((k*n) mod N) from a cosl/sinl table
+        roundtrip   larger N: x' = conj(F(conj(F(x)))) / N, or the
+                    kernel's own inverse, compared against x
+    Errors are relative to the reference:
+        max = max_k |X[k] - R[k]| / max_k |R[k]|
+        rms = sqrt(Σ|X[k] - R[k]|^2 / Σ|R[k]|^2)
+    worst over the four signals. A kernel is flagged when
+        rms > 2 eps log2(N)    or    max > 8 eps log2(N)
+    where eps is the unit roundoff of the kernel's precision:
+    double epsilon, or float epsilon for the single-precision
+    kernels. A correct O(N log N) transform with exact twiddles
+    stays well inside 2 eps log2(N), since its rms error grows only
+    like eps sqrt(log N); a bad twiddle recurrence or a broken stage
+    lands far above it. The
+    "x best" column compares each kernel with the most accurate one
+    at that N, so a new fast path that gives up digits shows up
+    even while it is still under the bound; it is taken within
+    each precision, so float kernels are ranked against each other.
+
+    The bit-reversal permutation is checked exactly against
+    ReverseBits at every power-of-two size.
+*/
+
+// Largest N checked against the long double DFT
+const u_int referenceMaxSize = 1u << 12;
+
+// Unit roundoff the bounds scale with
+const double doubleEpsilon = std::numeric_limits<double>::epsilon();
+const double floatEpsilon = std::numeric_limits<float>::epsilon();
+
+struct AccuracyTransform
+{
+    // forward transform of Size() values, in place
+    std::function<void(complex*)> forward;
+    // inverse including the 1/N; empty -> conj trick through forward
+    std::function<void(complex*)> inverse;
+};
+
+// Builds a kernel for N
+using AccuracySetup = std::function<AccuracyTransform(u_int size)>;
+
+struct AccuracyKernel
+{
+    std::string name;
+    AccuracySetup setup;
+    bool anySize;       // false -> powers of two only
+    bool realInput;     // transforms the real parts only
+    u_int maxSize;      // 0 -> no limit
+    double epsilon;     // doubleEpsilon or floatEpsilon
+};
+
+struct AccuracyResult
+{
+    std::string kernel;
+    u_int size;
+    bool roundTrip;
+    double maxError;
+    double rmsError;
+    double best;        // rmsError / lowest rmsError at this N and precision
+    double epsilon;
+    bool flagged;
+};
+
+class AccuracyCheck
+{
+public:
+    // powers of two up to 2^maxLog2, plus a few other sizes
+    AccuracyCheck(u_int _maxLog2 = 20);
+
+    void Add(const std::string& name, AccuracySetup setup,
+        bool anySize = false, bool realInput = false, u_int maxSize = 0,
+        double epsilon = doubleEpsilon);
+
+    // Every kernel at every size; returns the number flagged
+    u_int Run(std::ostream& log);
+
+    const std::vector<AccuracyResult>& Results() const { return results_; }
+
+private:
+    AccuracyResult Check(const AccuracyKernel& kernel, u_int size) const;
+    // mismatched positions of BitReversal against ReverseBits
+    u_int CheckPermutation(u_int size) const;
+
+    u_int maxLog2_;
+    std::vector<AccuracyKernel> kernels_;
+    std::vector<AccuracyResult> results_;
+};
+
+#endif // ACCURACY_H
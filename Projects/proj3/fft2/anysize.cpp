@@ -0,0 +1,132 @@
+#include "anysize.h"
+#include <algorithm>
+
+namespace
+{
+    // largest radix the mixed-radix path will take
+    const u_int maxRadix = 7;
+}
+
+AnySizeFFT::AnySizeFFT(u_int _size)
+: size_(_size), scratch_(_size)
+{
+    // pull out 4s first (fewer levels), then the small primes
+    u_int rest = size_;
+    while(rest % 4 == 0)
+    {
+        factors_.push_back(4);
+        rest /= 4;
+    }
+    for(u_int p = 2; p <= maxRadix; ++p)
+    {
+        while(rest % p == 0)
+        {
+            factors_.push_back(p);
+            rest /= p;
+        }
+    }
+
+    if(rest == 1)
+    {
+        twiddles_.resize(size_);
+        for(u_int j = 0; j < size_; ++j)
+        {
+            double angle = -2.0 * M_PI * j / size_;
+            twiddles_[j] = complex(cos(angle), sin(angle));
+        }
+        return;
+    }
+
+    // a prime factor above maxRadix: Bluestein over the whole N
+    factors_.clear();
+    u_int M = 1;
+    while(M < 2 * size_ - 1) M <<= 1;
+    convolution_.reset(new FFTPlan(M));
+
+    chirp_.resize(size_);
+    for(u_int n = 0; n < size_; ++n)
+    {
+        // n^2 mod 2N keeps the angle small and exact
+        unsigned long long square = static_cast<unsigned long long>(n) * n % (2ull * size_);
+        double angle = -M_PI * static_cast<double>(square) / size_;
+        chirp_[n] = complex(cos(angle), sin(angle));
+    }
+    chirpFFT_.assign(M, complex(0.0, 0.0));
+    chirpFFT_[0] = std::conj(chirp_[0]);
+    for(u_int n = 1; n < size_; ++n)
+    {
+        chirpFFT_[n] = std::conj(chirp_[n]);
+        chirpFFT_[M - n] = std::conj(chirp_[n]);
+    }
+    // kept in bit-reversed order, like the spectra it multiplies
+    convolution_->ForwardBitReversed(chirpFFT_);
+    scratch_.resize(M);
+}
+
+void AnySizeFFT::Execute(complex* data)
+{
+    if(UsesBluestein())
+    {
+        Bluestein(data);
+        return;
+    }
+    std::copy(data, data + size_, scratch_.begin());
+    MixedRadix(scratch_.data(), data, size_, 1, 0);
+}
+
+void AnySizeFFT::MixedRadix(const complex* in, complex* out,
+    u_int n, u_int stride, u_int factor) const
+{
+    if(n == 1)
+    {
+        out[0] = in[0];
+        return;
+    }
+    u_int p = factors_[factor];
+    u_int m = n / p;
+    // Y_j = DFT_m of x[j + p*r], stored at out + j*m
+    for(u_int j = 0; j < p; ++j)
+    {
+        MixedRadix(in + j * stride, out + j * m, m, stride * p, factor + 1);
+    }
+
+    // W_n^e = W_N^(e * step), W_p^e = W_N^(e * pStep)
+    u_int step = size_ / n;
+    u_int pStep = size_ / p;
+    complex t[maxRadix];
+    for(u_int k = 0; k < m; ++k)
+    {
+        t[0] = out[k];
+        for(u_int j = 1; j < p; ++j)
+        {
+            t[j] = twiddles_[j * k * step] * out[j * m + k];
+        }
+        // p-point DFT of t
+        for(u_int q = 0; q < p; ++q)
+        {
+            complex sum = t[0];
+            for(u_int j = 1; j < p; ++j)
+            {
+                sum += twiddles_[((j * q) % p) * pStep] * t[j];
+            }
+            out[q * m + k] = sum;
+        }
+    }
+}
+
+void AnySizeFFT::Bluestein(complex* data)
+{
+    u_int M = convolution_->Size();
+    // a[n] = x[n] c_n, zero padded to M
+    for(u_int n = 0; n < size_; ++n) scratch_[n] = data[n] * chirp_[n];
+    std::fill(scratch_.begin() + size_, scratch_.end(), complex(0.0, 0.0));
+
+    // both spectra in bit-reversed order: no permutation either way
+    convolution_->ForwardBitReversed(scratch_);
+    for(u_int i = 0; i < M; ++i) scratch_[i] *= chirpFFT_[i];
+    convolution_->InverseBitReversed(scratch_);
+    for(u_int k = 0; k < size_; ++k)
+    {
+        data[k] = chirp_[k] * scratch_[k];
+    }
+}
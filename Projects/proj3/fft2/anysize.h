@@ -0,0 +1,57 @@
+#ifndef ANYSIZE_H
+#define ANYSIZE_H
+
+#include <memory>
+#include "plan.h"
+
+/*
+    FFT for any N, not just powers of two.
+
+    7-smooth N (only factors 2, 3, 5, 7): mixed-radix Cooley-Tukey.
+        With N = p * m, split x into p interleaved sequences
+        x[j + p*r] and take their m-point DFTs Y_j. Then
+            X[k + q*m] = Σ_j (W_N^(jk) Y_j[k]) W_p^(jq)
+        i.e. twiddle the p values and run a p-point DFT on them.
+        Recursion walks the input with a growing stride and writes
+        the output contiguously, so no reordering pass is needed.
+
+    Anything else: Bluestein chirp-z on top of a power-of-two FFTPlan.
+        nk = (n^2 + k^2 - (k-n)^2) / 2, so with c_n = e^(-iπn^2/N)
+            X[k] = c_k Σ_n (x[n] c_n) conj(c_(k-n))
+        which is a convolution, done with three length-M FFTs
+        (M = power of two >= 2N-1). The chirp's FFT is precomputed,
+        and both spectra stay in bit-reversed order (FFTPlan's
+        ForwardBitReversed / InverseBitReversed), so the convolution
+        runs without a permutation pass.
+*/
+class AnySizeFFT
+{
+public:
+    AnySizeFFT(u_int _size);
+
+    // In place, through the object's scratch buffers
+    void Execute(complex* data);
+    void Execute(c_vector& data) { Execute(data.data()); }
+
+    u_int Size() const { return size_; }
+    bool UsesBluestein() const { return convolution_ != nullptr; }
+
+private:
+    void MixedRadix(const complex* in, complex* out,
+        u_int n, u_int stride, u_int factor) const;
+    void Bluestein(complex* data);
+
+    u_int size_;
+    // radices, largest first (4s, then 2, 3, 5, 7)
+    u_vector factors_;
+    // W_N^j for j < N
+    c_vector twiddles_;
+    c_vector scratch_;
+
+    // Bluestein only
+    std::unique_ptr<FFTPlan> convolution_;
+    c_vector chirp_;        // c_n
+    c_vector chirpFFT_;     // FFT of conj(c), wrapped to length M
+};
+
+#endif // ANYSIZE_H
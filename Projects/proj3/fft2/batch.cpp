@@ -0,0 +1,22 @@
+#include "batch.h"
+
+BatchFFT::BatchFFT(u_int _size, u_int _threads, Radix _radix)
+: plan_(_size, _radix), pool_(_threads)
+{}
+
+void BatchFFT::Execute(complex* block, u_int count)
+{
+    u_int N = plan_.Size();
+    pool_.ParallelFor(count, [this, block, N](u_int begin, u_int end)
+    {
+        for(u_int row = begin; row < end; ++row)
+        {
+            plan_.Execute(block + static_cast<size_t>(row) * N);
+        }
+    });
+}
+
+void BatchFFT::Execute(c_vector& block)
+{
+    Execute(block.data(), static_cast<u_int>(block.size() / plan_.Size()));
+}
@@ -0,0 +1,32 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "plan.h"
+#include "threadpool.h"
+
+/*
+    Many same-size transforms at once.
+    The input is one contiguous count x N block, row m holding
+    signal m. Every row runs through the same FFTPlan (its tables
+    are read-only, so threads can share it) and the rows are
+    spread across the pool's threads.
+*/
+class BatchFFT
+{
+public:
+    // _threads = 0 -> one per hardware core
+    BatchFFT(u_int _size, u_int _threads = 0, Radix _radix = Radix2);
+
+    // In place on count rows of Size() values
+    void Execute(complex* block, u_int count);
+    void Execute(c_vector& block);
+
+    u_int Size() const { return plan_.Size(); }
+    u_int Threads() const { return pool_.Threads(); }
+
+private:
+    FFTPlan plan_;
+    ThreadPool pool_;
+};
+
+#endif // BATCH_H
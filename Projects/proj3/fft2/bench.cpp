@@ -0,0 +1,181 @@
+#include "bench.h"
+#include "simd.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <thread>
+
+namespace
+{
+    using benchClock = std::chrono::steady_clock;
+
+    const double calibrateSeconds = 0.002;
+    const double budgetSeconds = 0.3;
+    const u_int minSamples = 5;
+    const u_int maxSamples = 51;
+
+    double Seconds(benchClock::time_point start, benchClock::time_point end)
+    {
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    // seconds for inner back-to-back calls, each on a restored input
+    double Sample(const BenchCall& call, u_int inner)
+    {
+        benchClock::time_point start = benchClock::now();
+        if(call.restore)
+        {
+            for(u_int i = 0; i < inner; ++i)
+            {
+                call.restore();
+                call.run();
+            }
+        }
+        else
+        {
+            for(u_int i = 0; i < inner; ++i) call.run();
+        }
+        return Seconds(start, benchClock::now());
+    }
+
+    // seconds for inner restores alone, median of minSamples
+    double RestoreSeconds(const BenchCall& call, u_int inner)
+    {
+        if(!call.restore) return 0.0;
+        std::vector<double> times;
+        while(times.size() < minSamples)
+        {
+            benchClock::time_point start = benchClock::now();
+            for(u_int i = 0; i < inner; ++i) call.restore();
+            times.push_back(Seconds(start, benchClock::now()));
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+}
+
+Benchmark::Benchmark(u_int _minLog2, u_int _maxLog2)
+: minLog2_(_minLog2), maxLog2_(_maxLog2)
+{}
+
+void Benchmark::Add(const std::string& name, BenchSetup setup,
+    u_int maxSize, double flopScale, u_int batch)
+{
+    kernels_.push_back({name, setup, maxSize, flopScale, batch});
+}
+
+BenchResult Benchmark::Measure(const BenchKernel& kernel, u_int size, const c_vector& input) const
+{
+    BenchCall call = kernel.setup(size, input);
+
+    // calibrate: how many calls make a sample long enough to time
+    u_int calls = 0;
+    benchClock::time_point start = benchClock::now();
+    double elapsed = 0.0;
+    while(elapsed < calibrateSeconds)
+    {
+        if(call.restore) call.restore();
+        call.run();
+        ++calls;
+        elapsed = Seconds(start, benchClock::now());
+    }
+    u_int inner = std::max(1u, static_cast<u_int>(calibrateSeconds * calls / elapsed));
+
+    Sample(call, inner);
+    double restore = RestoreSeconds(call, inner);
+
+    std::vector<double> times;
+    double spent = 0.0;
+    while(times.size() < minSamples || (spent < budgetSeconds && times.size() < maxSamples))
+    {
+        double seconds = Sample(call, inner);
+        spent += seconds;
+        times.push_back(std::max(0.0, seconds - restore) / inner / kernel.batch);
+    }
+    std::sort(times.begin(), times.end());
+
+    BenchResult result;
+    result.kernel = kernel.name;
+    result.size = size;
+    result.samples = static_cast<u_int>(times.size());
+    result.inner = inner;
+    result.medianNs = times[times.size() / 2] * 1e9;
+    // nearest-rank 95th percentile
+    size_t rank = (times.size() * 95 + 99) / 100;
+    result.p95Ns = times[rank - 1] * 1e9;
+    result.nsPerPoint = result.medianNs / size;
+    result.gflops = kernel.flopScale * 5.0 * size * std::log2(static_cast<double>(size))
+        / result.medianNs;
+    return result;
+}
+
+void Benchmark::Run(std::ostream& log)
+{
+    // wide enough for the longest name plus a space
+    size_t nameWidth = 18;
+    for(const auto& kernel : kernels_) nameWidth = std::max(nameWidth, kernel.name.size() + 1);
+
+    log << std::left << std::setw(nameWidth) << "kernel" << std::right
+    << std::setw(10) << "N" << std::setw(14) << "median ns" << std::setw(14) << "p95 ns"
+    << std::setw(12) << "ns/pt" << std::setw(10) << "GFLOP/s" << std::endl;
+
+    std::mt19937 random(320);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for(u_int log2 = minLog2_; log2 <= maxLog2_; ++log2)
+    {
+        u_int N = 1u << log2;
+        c_vector input(N);
+        for(auto& value : input) value = complex(uniform(random), uniform(random));
+
+        for(const auto& kernel : kernels_)
+        {
+            if(kernel.maxSize != 0 && N > kernel.maxSize) continue;
+            BenchResult result = Measure(kernel, N, input);
+            results_.push_back(result);
+            log << std::left << std::setw(nameWidth) << result.kernel << std::right
+            << std::setw(10) << N << std::fixed << std::setprecision(0)
+            << std::setw(14) << result.medianNs << std::setw(14) << result.p95Ns
+            << std::setprecision(3) << std::setw(12) << result.nsPerPoint
+            << std::setprecision(2) << std::setw(10) << result.gflops << std::endl;
+        }
+    }
+}
+
+bool Benchmark::WriteCSV(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if(!file.is_open()) return false;
+    file << "kernel,n,samples,inner,median_ns,p95_ns,ns_per_point,gflops\n";
+    file << std::setprecision(6);
+    for(const auto& result : results_)
+    {
+        file << result.kernel << "," << result.size << "," << result.samples << ","
+        << result.inner << "," << result.medianNs << "," << result.p95Ns << ","
+        << result.nsPerPoint << "," << result.gflops << "\n";
+    }
+    return file.good();
+}
+
+bool Benchmark::WriteJSON(const std::string& filename) const
+{
+    std::ofstream file(filename);
+    if(!file.is_open()) return false;
+    file << std::setprecision(6);
+    file << "{\n";
+    file << "  \"simd\": \"" << KernelName(BestKernel()) << "\",\n";
+    file << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    file << "  \"results\": [\n";
+    for(size_t i = 0; i < results_.size(); ++i)
+    {
+        const BenchResult& result = results_[i];
+        file << "    {\"kernel\": \"" << result.kernel << "\", \"n\": " << result.size
+        << ", \"samples\": " << result.samples << ", \"inner\": " << result.inner
+        << ", \"median_ns\": " << result.medianNs << ", \"p95_ns\": " << result.p95Ns
+        << ", \"ns_per_point\": " << result.nsPerPoint << ", \"gflops\": " << result.gflops
+        << "}" << (i + 1 < results_.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    return file.good();
+}
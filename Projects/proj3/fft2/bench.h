@@ -0,0 +1,92 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "plan.h"
+
+/*
+    Benchmark sweep over transform sizes N = 2^minLog2 .. 2^maxLog2.
+    Each kernel is registered with a setup function that builds
+    whatever it needs for one N (plans, buffers) and returns the
+    transform to time, so table construction stays out of the
+    measurement. Per (kernel, N):
+        calibrate   run until 2 ms have passed, pick an inner repeat
+                    count so one sample takes about 2 ms
+        warmup      one untimed sample
+        samples     at least 5, more until 0.3 s have been spent
+                    (at most 51)
+    Reported per transform: median and p95 time, ns per point and
+        GFLOP/s = flopScale * 5 N log2(N) / median
+    Batched kernels run batch transforms per call (each on a copy of
+    the input) and every figure is per transform.
+    5 N log2 N is the usual nominal FFT count (radix-2 butterflies),
+    used for every kernel so the numbers compare directly; for the
+    O(N^2) DFT it is an "equivalent FFT rate", not work done.
+
+    An in-place kernel re-run on its own output grows by sqrt(N) a
+    run and reaches inf/NaN within a few dozen runs, where every
+    std::complex multiply takes the slow libcall path. Such kernels
+    come with a restore call that copies the input back before each
+    run; the same number of restores is timed on its own and
+    subtracted from every sample.
+*/
+
+struct BenchCall
+{
+    std::function<void()> run;      // the call to time
+    std::function<void()> restore;  // empty if run leaves its input alone
+};
+
+// Builds a kernel for N from the shared input, returns the call to time
+using BenchSetup = std::function<BenchCall(u_int size, const c_vector& input)>;
+
+struct BenchKernel
+{
+    std::string name;
+    BenchSetup setup;
+    u_int maxSize;      // 0 -> no limit
+    double flopScale;   // 0.5 for real-input transforms
+    u_int batch;        // transforms per call
+};
+
+struct BenchResult
+{
+    std::string kernel;
+    u_int size;
+    u_int samples;
+    u_int inner;        // calls per sample
+    double medianNs;
+    double p95Ns;
+    double nsPerPoint;
+    double gflops;
+};
+
+class Benchmark
+{
+public:
+    Benchmark(u_int _minLog2 = 4, u_int _maxLog2 = 24);
+
+    void Add(const std::string& name, BenchSetup setup,
+        u_int maxSize = 0, double flopScale = 1.0, u_int batch = 1);
+
+    // Every kernel at every size, one table line per result to log
+    void Run(std::ostream& log);
+
+    bool WriteCSV(const std::string& filename) const;
+    bool WriteJSON(const std::string& filename) const;
+
+    const std::vector<BenchResult>& Results() const { return results_; }
+
+private:
+    BenchResult Measure(const BenchKernel& kernel, u_int size, const c_vector& input) const;
+
+    u_int minLog2_;
+    u_int maxLog2_;
+    std::vector<BenchKernel> kernels_;
+    std::vector<BenchResult> results_;
+};
+
+#endif // BENCH_H
@@ -0,0 +1,55 @@
+#include "codelets.h"
+
+namespace
+{
+    // one out-of-line copy per size, each fully unrolled inside
+    template<u_int N, typename C>
+    void Run(C* data)
+    {
+        codelet::Codelet<N>::Execute(data);
+    }
+
+    template<u_int N, typename C>
+    void RunDif(C* data)
+    {
+        codelet::DifCodelet<N>::Execute(data);
+    }
+
+    template<typename C>
+    bool Dispatch(C* data, u_int n)
+    {
+        switch(n)
+        {
+            case 1: return true;
+            case 2: Run<2>(data); return true;
+            case 4: Run<4>(data); return true;
+            case 8: Run<8>(data); return true;
+            case 16: Run<16>(data); return true;
+            case 32: Run<32>(data); return true;
+            case 64: Run<64>(data); return true;
+            default: return false;
+        }
+    }
+
+    template<typename C>
+    bool DispatchDif(C* data, u_int n)
+    {
+        switch(n)
+        {
+            case 1: return true;
+            case 2: RunDif<2>(data); return true;
+            case 4: RunDif<4>(data); return true;
+            case 8: RunDif<8>(data); return true;
+            case 16: RunDif<16>(data); return true;
+            case 32: RunDif<32>(data); return true;
+            case 64: RunDif<64>(data); return true;
+            default: return false;
+        }
+    }
+}
+
+bool RunCodelet(complex* data, u_int n) { return Dispatch(data, n); }
+bool RunCodelet(f_complex* data, u_int n) { return Dispatch(data, n); }
+
+bool RunDifCodelet(complex* data, u_int n) { return DispatchDif(data, n); }
+bool RunDifCodelet(f_complex* data, u_int n) { return DispatchDif(data, n); }
@@ -0,0 +1,187 @@
+#ifndef CODELETS_H
+#define CODELETS_H
+
+#include <utility>
+#include "plan.h"
+
+// Largest straight-line codelet, and the leaf size larger
+// radix-2 / split-radix transforms hand to the codelets
+const u_int codeletMaxSize = 64;
+
+// Run the n-point codelet on bit-reversed input in place.
+// Returns false (and does nothing) if there is no codelet for n.
+bool RunCodelet(complex* data, u_int n);
+bool RunCodelet(f_complex* data, u_int n);
+// Decimation-in-frequency mirror: natural-order input, output left
+// in bit-reversed order. Same return convention.
+bool RunDifCodelet(complex* data, u_int n);
+bool RunDifCodelet(f_complex* data, u_int n);
+
+/*
+    Fully unrolled small-N FFTs, generated at compile time.
+    Codelet<N> does the same work as the radix-2 stages on one
+    bit-reversed block of N values:
+        Codelet<N/2> on each half, then N/2 butterflies
+    but every loop is a template expansion and every twiddle
+    W_N^k is a constexpr double pair, so the compiled code is a
+    straight line of loads, multiplies and stores. W^0 = 1 and
+    W^(N/4) = -i skip the multiply altogether. C is the complex
+    type; float codelets round the same constants to float.
+*/
+namespace codelet
+{
+    constexpr long double pi = 3.141592653589793238462643383279502884L;
+
+    // Taylor series in long double, only used for |x| <= π/4
+    // where 20 terms are far past double precision
+    constexpr double SinSeries(long double x)
+    {
+        long double term = x;
+        long double sum = x;
+        for(int n = 1; n < 20; ++n)
+        {
+            term *= -x * x / ((2.0L * n) * (2.0L * n + 1.0L));
+            sum += term;
+        }
+        return static_cast<double>(sum);
+    }
+    constexpr double CosSeries(long double x)
+    {
+        long double term = 1.0L;
+        long double sum = 1.0L;
+        for(int n = 1; n < 20; ++n)
+        {
+            term *= -x * x / ((2.0L * n - 1.0L) * (2.0L * n));
+            sum += term;
+        }
+        return static_cast<double>(sum);
+    }
+
+    // cos and sin of 2πk/n for 0 <= k < n/2, folded into
+    // the first octant with exact integer arithmetic
+    constexpr double Sin(u_int k, u_int n);
+    constexpr double Cos(u_int k, u_int n)
+    {
+        if(4 * k > n) return -Sin(k - n / 4, n);
+        if(8 * k > n) return SinSeries(2.0L * pi * (n / 4 - k) / n);
+        return CosSeries(2.0L * pi * k / n);
+    }
+    constexpr double Sin(u_int k, u_int n)
+    {
+        if(4 * k > n) return Cos(k - n / 4, n);
+        if(8 * k > n) return CosSeries(2.0L * pi * (n / 4 - k) / n);
+        return SinSeries(2.0L * pi * k / n);
+    }
+
+    // x[k], x[k + N/2] <- E + W_N^k O, E - W_N^k O
+    template<u_int N, u_int K, typename C>
+    inline __attribute__((always_inline)) void Butterfly(C* x)
+    {
+        using Real = typename C::value_type;
+        C even = x[K];
+        C odd = x[K + N / 2];
+        Real tr, ti;
+        if constexpr(K == 0)
+        {
+            tr = odd.real();
+            ti = odd.imag();
+        }
+        else if constexpr(4 * K == N)
+        {
+            // -i * odd
+            tr = odd.imag();
+            ti = -odd.real();
+        }
+        else
+        {
+            // W_N^k = cos - i sin
+            constexpr Real wr = static_cast<Real>(Cos(K, N));
+            constexpr Real wi = static_cast<Real>(-Sin(K, N));
+            tr = wr * odd.real() - wi * odd.imag();
+            ti = wr * odd.imag() + wi * odd.real();
+        }
+        x[K] = C(even.real() + tr, even.imag() + ti);
+        x[K + N / 2] = C(even.real() - tr, even.imag() - ti);
+    }
+
+    template<u_int N, typename C, std::size_t... K>
+    inline __attribute__((always_inline)) void Combine(C* x, std::index_sequence<K...>)
+    {
+        (Butterfly<N, static_cast<u_int>(K)>(x), ...);
+    }
+
+    template<u_int N>
+    struct Codelet
+    {
+        template<typename C>
+        static inline __attribute__((always_inline)) void Execute(C* x)
+        {
+            Codelet<N / 2>::Execute(x);
+            Codelet<N / 2>::Execute(x + N / 2);
+            Combine<N>(x, std::make_index_sequence<N / 2>());
+        }
+    };
+
+    template<>
+    struct Codelet<1>
+    {
+        template<typename C>
+        static inline void Execute(C*) {}
+    };
+
+    // DIF: x[k], x[k + N/2] <- a + b, (a - b) W_N^k
+    template<u_int N, u_int K, typename C>
+    inline __attribute__((always_inline)) void DifButterfly(C* x)
+    {
+        using Real = typename C::value_type;
+        C a = x[K];
+        C b = x[K + N / 2];
+        Real dr = a.real() - b.real();
+        Real di = a.imag() - b.imag();
+        x[K] = C(a.real() + b.real(), a.imag() + b.imag());
+        if constexpr(K == 0)
+        {
+            x[K + N / 2] = C(dr, di);
+        }
+        else if constexpr(4 * K == N)
+        {
+            // -i * (a - b)
+            x[K + N / 2] = C(di, -dr);
+        }
+        else
+        {
+            constexpr Real wr = static_cast<Real>(Cos(K, N));
+            constexpr Real wi = static_cast<Real>(-Sin(K, N));
+            x[K + N / 2] = C(wr * dr - wi * di, wr * di + wi * dr);
+        }
+    }
+
+    template<u_int N, typename C, std::size_t... K>
+    inline __attribute__((always_inline)) void Split(C* x, std::index_sequence<K...>)
+    {
+        (DifButterfly<N, static_cast<u_int>(K)>(x), ...);
+    }
+
+    // N butterflies first, then the two halves: the stages of
+    // Codelet<N> in reverse with the butterfly transposed
+    template<u_int N>
+    struct DifCodelet
+    {
+        template<typename C>
+        static inline __attribute__((always_inline)) void Execute(C* x)
+        {
+            Split<N>(x, std::make_index_sequence<N / 2>());
+            DifCodelet<N / 2>::Execute(x);
+            DifCodelet<N / 2>::Execute(x + N / 2);
+        }
+    };
+
+    template<>
+    struct DifCodelet<1>
+    {
+        template<typename C>
+        static inline void Execute(C*) {}
+    };
+}
+
+#endif // CODELETS_H
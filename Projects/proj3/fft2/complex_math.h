@@ -0,0 +1,13 @@
+#ifndef COMPLEX_MATH_H
+#define COMPLEX_MATH_H
+
+#include <complex>
+
+// w * v without the NaN-checking libcall of std::complex
+template<typename Real>
+inline std::complex<Real> Rotate(const std::complex<Real>& w, Real vr, Real vi)
+{
+    return std::complex<Real>(w.real() * vr - w.imag() * vi, w.real() * vi + w.imag() * vr);
+}
+
+#endif // COMPLEX_MATH_H
@@ -0,0 +1,32 @@
+#include "convolution.h"
+#include <algorithm>
+
+Convolution::Convolution(u_int _size, const c_vector& _filter)
+: plan_(_size), spectrum_(_size, complex(0.0, 0.0))
+{
+    std::copy(_filter.begin(), _filter.begin() + std::min<size_t>(_filter.size(), _size),
+        spectrum_.begin());
+    plan_.ForwardBitReversed(spectrum_);
+}
+
+void Convolution::Execute(complex* data) const
+{
+    plan_.ForwardBitReversed(data);
+    for(u_int i = 0; i < plan_.Size(); ++i) data[i] *= spectrum_[i];
+    plan_.InverseBitReversed(data);
+}
+
+c_vector Convolve(const c_vector& a, const c_vector& b)
+{
+    if(a.empty() || b.empty()) return c_vector();
+    size_t length = a.size() + b.size() - 1;
+    u_int N = 1;
+    while(N < length) N <<= 1;
+
+    Convolution convolution(N, b);
+    c_vector result(N, complex(0.0, 0.0));
+    std::copy(a.begin(), a.end(), result.begin());
+    convolution.Execute(result);
+    result.resize(length);
+    return result;
+}
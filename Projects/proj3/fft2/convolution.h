@@ -0,0 +1,41 @@
+#ifndef CONVOLUTION_H
+#define CONVOLUTION_H
+
+#include "plan.h"
+
+/*
+    Fast convolution without the bit-reversal passes.
+        y = x ⊛ h = IDFT(DFT(x) · DFT(h))     (circular, length N)
+    The product is taken bin by bin, so the order of the bins does
+    not matter as long as both spectra use the same one: x goes
+    through FFTPlan::ForwardBitReversed, the filter spectrum is
+    stored in the same bit-reversed order once at construction, and
+    FFTPlan::InverseBitReversed takes the product straight back to
+    natural order. Each call is two permutation-free transforms and
+    one pointwise multiply.
+
+    A linear convolution of lengths La and Lb is the circular one
+    at any N >= La + Lb - 1 with both inputs zero padded.
+*/
+class Convolution
+{
+public:
+    // N a power of two; _filter holds at most N taps (zero padded)
+    Convolution(u_int _size, const c_vector& _filter);
+
+    // data (N values) <- data ⊛ filter, in place
+    void Execute(complex* data) const;
+    void Execute(c_vector& data) const { Execute(data.data()); }
+
+    u_int Size() const { return plan_.Size(); }
+
+private:
+    FFTPlan plan_;
+    // DFT of the filter, bit-reversed order
+    c_vector spectrum_;
+};
+
+// Linear convolution, La + Lb - 1 values (empty if either is empty)
+c_vector Convolve(const c_vector& a, const c_vector& b);
+
+#endif // CONVOLUTION_H
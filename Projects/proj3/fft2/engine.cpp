@@ -0,0 +1,63 @@
+#include "engine.h"
+#include "anysize.h"
+#include "fourstep.h"
+#include "wisdom.h"
+#include <memory>
+
+FFTEngine::FFTEngine(u_int _size, Radix _radix)
+: size_(_size)
+{
+    if(size_ == 0)
+    {
+        algorithm_ = "none";
+        transform_ = [](complex*) {};
+        return;
+    }
+    // non powers of two: mixed radix or Bluestein (see anysize.h)
+    if((size_ & (size_ - 1)) != 0)
+    {
+        auto any = std::make_shared<AnySizeFFT>(size_);
+        algorithm_ = "anysize";
+        transform_ = [any](complex* data) { any->Execute(data); };
+        return;
+    }
+    // the kernel tuned for this N on this machine, if any (see wisdom.h)
+    const WisdomEntry* tuned = (_radix == Radix2) ? SharedWisdom().Lookup(size_) : nullptr;
+    transform_ = tuned ? Wisdom::Build(tuned->kernel, size_) : WisdomTransform();
+    if(transform_)
+    {
+        algorithm_ = tuned->kernel;
+        return;
+    }
+    // very large N: cache-sized sub-FFTs on every core (see fourstep.h)
+    if(size_ >= fourStepMinSize && _radix == Radix2)
+    {
+        auto fourStep = std::make_shared<FourStepFFT>(size_);
+        algorithm_ = "fourstep";
+        transform_ = [fourStep](complex* data) { fourStep->Execute(data); };
+        return;
+    }
+    // bit reversal + butterflies, with twiddles and reversed indices
+    // precomputed once for this N (see plan.h)
+    auto plan = std::make_shared<FFTPlan>(size_, _radix);
+    algorithm_ = std::string("plan-") + RadixName(_radix);
+    transform_ = [plan](complex* data) { plan->Execute(data); };
+}
+
+void FFTEngine::Execute(complex* data)
+{
+    transform_(data);
+}
+
+void FFTEngine::Execute(complex* data, size_t stride)
+{
+    if(stride == 1)
+    {
+        transform_(data);
+        return;
+    }
+    scratch_.resize(size_);
+    for(u_int i = 0; i < size_; ++i) scratch_[i] = data[i * stride];
+    transform_(scratch_.data());
+    for(u_int i = 0; i < size_; ++i) data[i * stride] = scratch_[i];
+}
@@ -0,0 +1,60 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include "plan.h"
+
+#if defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#endif
+
+/*
+    Library entry point over caller-owned memory.
+    FFTEngine makes the same kernel choice FFT2::Execute does and
+    then transforms whatever buffer it is handed, in place: no file,
+    no vector of its own, nothing kept between calls but the plan.
+        N not a power of two    AnySizeFFT
+        tuned N (wisdom.h)      the kernel --tune picked, default radix only
+        N >= fourStepMinSize    FourStepFFT, default radix only
+        otherwise               FFTPlan with the requested radix
+    Everything N-dependent (tables, scratch) is built once in the
+    constructor, so a frame loop pays only for the transform:
+        FFTEngine fft(1024);
+        for(each frame) fft.Execute(frame, 1024);
+    A contiguous buffer (stride 1) is never copied. A strided view
+    (every stride-th value, e.g. one channel of interleaved audio)
+    is gathered into the engine's scratch, transformed and scattered
+    back, since every kernel here works on contiguous data.
+    Like SimdPlan, an engine holds scratch: one per thread.
+*/
+class FFTEngine
+{
+public:
+    FFTEngine(u_int _size, Radix _radix = Radix2);
+
+    // Size() values at data, in place
+    void Execute(complex* data);
+    // Size() values at data[0], data[stride], data[2*stride], ...
+    void Execute(complex* data, size_t stride);
+    void Execute(c_vector& data) { Execute(data.data()); }
+#ifdef __cpp_lib_span
+    // data.size() must equal Size()
+    void Execute(std::span<complex> data) { Execute(data.data()); }
+#endif
+
+    u_int Size() const { return size_; }
+    // kernel chosen for this N, named as in --bench and --tune
+    const std::string& Algorithm() const { return algorithm_; }
+
+private:
+    u_int size_;
+    std::string algorithm_;
+    std::function<void(complex*)> transform_;
+    c_vector scratch_;  // strided views only, sized on first use
+};
+
+#endif // ENGINE_H
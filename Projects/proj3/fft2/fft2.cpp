@@ -3,35 +3,16 @@
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
+#include <memory>
+#include <type_traits>
 
 
-void PrintFormattedVector(c_vector input)
+void PrintFormattedVector(const c_vector& input)
 {
-    for(auto num: input)
+    ComplexWriter writer;
+    for(const auto& num: input)
     {
-        double real = num.real();
-        double imag = num.imag();
-        if(real == (int)real)
-        {
-            std::cout << std::fixed << std::setprecision(0)
-            << (int)real;
-        } else {
-            std::cout << std::fixed << std::setprecision(3) << real;
-        }
-        if(imag >= 0)
-        {
-            //std::setprecision(0);
-            std::cout << "+";
-        } 
-        if(imag == (int)imag)
-        {
-            std::cout << std::fixed << std::setprecision(0)
-            <<  (int)imag;
-        } else {
-            std::cout << std::fixed << std::setprecision(3) << imag;
-        }
-        
-        std::cout << "i" << std::endl;
+        writer.Formatted(num);
     }
 }
 
@@ -57,51 +38,42 @@ k full rotations.
 
 */
 
-void FFT2::Execute() 
+template<typename Real>
+void BasicFFT2<Real>::Execute() 
 {
-    // have already verifed is power of two and expected input size
-    // index swapping in-place with bit reversal
-    for(u_int i = 0; i < size_; ++i)
-    {
-        u_int reversed = Reverse(i);
-        // only swap if lower index (crossover)
-        if(i < reversed) std::swap(numbers_[i], numbers_[reversed]);
-    }
-    // iterate through stages (log2(N) stages)
-    for(u_int stage = 1; stage <= countBits(size_); ++stage)
-    {
-        // 2^stage
-        u_int blockSize = 1 << stage; 
-        // "base case" root of unit
-        complex principle = 
-            std::exp(complex(0, -2.0 * M_PI / blockSize));
-        // iterate over current block
-        for(u_int blockIndex = 0; 
-            blockIndex < size_; 
-            blockIndex += blockSize)
-        {
-            complex twiddle = 1.0;
-            // Butterfly operation - combine dft of adjacent indices
-            for(u_int i = 0; i < blockSize/2; ++i)
-            {
-                // Even index -> first in vector
-                u_int evenIndex = blockIndex + i;
-                u_int oddIndex = evenIndex + blockSize/2;
-
-                // Butterfly - mirrored operations
-                complex twiddleOdd = twiddle * numbers_[oddIndex];
-                complex even = numbers_[evenIndex];
-                numbers_[evenIndex] = even + twiddleOdd;
-                numbers_[oddIndex] = even - twiddleOdd;
-
-                twiddle *= principle;
-            }
-        }
+    // have already verifed expected input size; which kernel runs
+    // is FFTEngine's choice (see engine.h), FFT2 only owns the data
+    // and keeps the engine or plan for the next call
+    bool single = !std::is_same<Real, double>::value && isPowerTwo(size_);
+    if(planSize_ != size_ || planRadix_ != radix_ || (single ? !plan_ : !engine_))
+    {
+        engine_.reset();
+        plan_.reset();
+        if(single) plan_ = std::make_shared<BasicFFTPlan<Real>>(size_, radix_);
+        else engine_ = std::make_shared<FFTEngine>(size_, radix_);
+        planSize_ = size_;
+        planRadix_ = radix_;
     }
 
+    if constexpr(std::is_same<Real, double>::value)
+    {
+        engine_->Execute(numbers_);
+    }
+    else if(single)
+    {
+        plan_->Execute(numbers_);
+    }
+    else
+    {
+        // no float any-size kernel: widen, transform, round back
+        c_vector wide(numbers_.begin(), numbers_.end());
+        engine_->Execute(wide);
+        numbers_.assign(wide.begin(), wide.end());
+    }
 }
 
-c_vector FFT::Execute(c_vector input)
+template<typename Real>
+typename BasicFFT<Real>::Vector BasicFFT<Real>::Execute(Vector input)
 {
     int N = static_cast<int>(input.size());
     // std::cout << "FFT called with N=" << N << std::endl;
@@ -110,21 +82,21 @@ c_vector FFT::Execute(c_vector input)
         return input;
     }
     
-    c_vector even, odd;
+    Vector even, odd;
     for(int i = 0; i < N; i+=2) {
         even.push_back(input[i]);
     }
     for(int i = 1; i < N; i+=2) {        
         odd.push_back(input[i]);
     }       
-    c_vector evenRes = Execute(even);
-    c_vector oddRes = Execute(odd);
+    Vector evenRes = Execute(even);
+    Vector oddRes = Execute(odd);
             
-    c_vector result(N);
+    Vector result(N);
     for(int k = 0; k < N/2; ++k) {       
         double angle = -2.0 * M_PI * k / N;
-        complex twiddle(cos(angle), sin(angle));
-        complex t = twiddle * oddRes[k];
+        Complex twiddle(cos(angle), sin(angle));
+        Complex t = twiddle * oddRes[k];
         
         result[k] = evenRes[k] + t;
         result[k + N/2] = evenRes[k] - t;        
@@ -133,37 +105,59 @@ c_vector FFT::Execute(c_vector input)
     return result;
 }
 
-void FFT::Read()
+/*
+    Strided recursion: the even and odd halves are never copied out.
+    The even samples of a stride-s view are a stride-2s view of the
+    same buffer starting at 0, the odd ones start at s. Each half
+    writes its DFT into its half of output, and the butterflies
+    then combine them in place, with the same twiddle and the same
+    operation order as Execute(CVector), so the results are
+    bit-for-bit identical.
+*/
+template<typename Real>
+void BasicFFT<Real>::ExecuteStrided(const Complex* input, Complex* output, int N, int stride)
 {
-    string line;
-    std::ifstream file(filename_);
-    if(!file.is_open()){
-        std::cerr << "Error opening file " << filename_ << std::endl;
+    if(N == 1) {
+        output[0] = input[0];
         return;
     }
-    while(std::getline(file, line))
-    {
-        complex num;
-        double real, imag;
-        char plus, i;
-        std::istringstream stream(line);
-        if(stream >> real >> plus >> imag >> i){
-            double imagFinal = (plus == '-') ? -imag : imag;
-            num = complex(real, imagFinal);
-            numbers_.emplace_back(num);
-            // std::cout << "Read from " << filename << " "
-            // << num << std::endl;
-        }
+    int half = N / 2;
+    ExecuteStrided(input, output, half, 2 * stride);
+    ExecuteStrided(input + stride, output + half, half, 2 * stride);
+
+    for(int k = 0; k < half; ++k) {
+        double angle = -2.0 * M_PI * k / N;
+        Complex twiddle(cos(angle), sin(angle));
+        Complex t = twiddle * output[k + half];
+        Complex even = output[k];
+
+        output[k] = even + t;
+        output[k + half] = even - t;
     }
+}
+
+template<typename Real>
+void BasicFFT<Real>::Execute(const Vector& input, Vector& output)
+{
+    output.resize(input.size());
+    ExecuteStrided(input.data(), output.data(), static_cast<int>(input.size()), 1);
+}
 
+template<typename Real>
+void BasicFFT<Real>::Read()
+{
+    c_vector values = ReadComplexFile(filename_);
+    numbers_.assign(values.begin(), values.end());
 }
 
-void FFT::Print()
+template<typename Real>
+void BasicFFT<Real>::Print()
 {
-    PrintFormattedVector(result_);
+    PrintFormattedVector(c_vector(result_.begin(), result_.end()));
 }
 
-void DFT::Execute()
+template<typename Real>
+void BasicDFT<Real>::Execute()
 {
     for(int k = 0; k < (int)size_; ++k)
     {
@@ -171,20 +165,66 @@ void DFT::Execute()
         for(int n = 0; n < (int)size_; ++n)
         {
             double angle = -2.0 * M_PI * k * n / size_;
-            complex twiddle(cos(angle), sin(angle));
+            Complex twiddle(cos(angle), sin(angle));
             result_[k] += vec1_[n] * twiddle;
         }
     }
 }
 
-void DFT::Print()
+template<typename Real>
+void BasicDFT<Real>::ExecuteTable(u_int threads)
+{
+    u_int N = size_;
+    // W_N^j for j < N; W^(kn) = W^((kn) mod N)
+    std::vector<Real> twiddleRe(N), twiddleIm(N);
+    for(u_int j = 0; j < N; ++j)
+    {
+        double angle = -2.0 * M_PI * j / N;
+        twiddleRe[j] = cos(angle);
+        twiddleIm[j] = sin(angle);
+    }
+
+    ThreadPool pool(threads);
+    pool.ParallelFor(N, [&](u_int begin, u_int end)
+    {
+        for(u_int k = begin; k < end; ++k)
+        {
+            Real re = 0, im = 0;
+            // index = (k*n) mod N, stepped by k without a multiply.
+            // The wrap is done with a mask: as a branch it would
+            // mispredict about half the time for most k.
+            u_int index = 0;
+            for(u_int n = 0; n < N; ++n)
+            {
+                Real xr = vec1_[n].real(), xi = vec1_[n].imag();
+                Real wr = twiddleRe[index], wi = twiddleIm[index];
+                re += xr * wr - xi * wi;
+                im += xr * wi + xi * wr;
+                index += k;
+                index -= N & (0u - static_cast<u_int>(index >= N));
+            }
+            result_[k] = Complex(re, im);
+        }
+    });
+}
+
+template<typename Real>
+void BasicDFT<Real>::Print()
 {
+    ComplexWriter writer;
     for(const auto& c : result_)
     {
-        std::cout << c.real() << " " << c.imag() << std::endl;
+        writer.Plain(complex(c));
     }
 }
 
+template class BasicFFT2<double>;
+template class BasicFFT2<float>;
+template class BasicFFT<double>;
+template class BasicFFT<float>;
+template class BasicDFT<double>;
+template class BasicDFT<float>;
+
 void Timing::test_dft(u_int size, const c_vector vector)
 {
     timePoint start = NowTime();
@@ -197,25 +237,97 @@ void Timing::test_dft(u_int size, const c_vector vector)
 
 void Timing::test_fftRec(const c_vector input)
 {
+    c_vector output(input.size());
     timePoint start = NowTime();
     FFT fourier("", input.size());
-    fourier.Execute(input);
+    fourier.Execute(input, output);
     timePoint end = NowTime();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     fftRecursive_Speed = duration.count() / 1000000.0;
 }
 
-void Timing::test_fftIP(const c_vector input)
+void Timing::test_fftIP(c_vector input)
 {
+    // the engine works on the caller's buffer: plan construction and
+    // the transform are timed, no copy into an FFT2
     timePoint start = NowTime();
-    FFT2 fourier(input.size(), "");
-    fourier.numbers_ = input;  // Copy the input data
-    fourier.Execute();
+    FFTEngine engine(input.size());
+    engine.Execute(input);
     timePoint end = NowTime();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
     fftInPlace_Speed = duration.count() / 1000000.0;
 }
 
+void Timing::test_radix(Radix radix, const c_vector input)
+{
+    // plan is built outside the timed region, the point of a plan
+    // is to pay for the tables once
+    FFTPlan plan(input.size(), radix);
+    c_vector data = input;
+    timePoint start = NowTime();
+    plan.Execute(data);
+    timePoint end = NowTime();
+    std::chrono::duration<double> duration = end - start;
+    radix_Speed[radix] = duration.count();
+}
+
+void Timing::test_stockham(const c_vector input)
+{
+    StockhamFFT stockham(input.size());
+    c_vector data = input;
+    timePoint start = NowTime();
+    stockham.Execute(data);
+    timePoint end = NowTime();
+    std::chrono::duration<double> duration = end - start;
+    stockham_Speed = duration.count();
+}
+
+void Timing::test_simd(Kernel kernel, const c_vector input)
+{
+    if(!KernelSupported(kernel)) return;
+    SimdPlan plan(input.size(), kernel);
+    std::vector<double> re(input.size()), im(input.size());
+    for(size_t i = 0; i < input.size(); ++i)
+    {
+        re[i] = input[i].real();
+        im[i] = input[i].imag();
+    }
+    timePoint start = NowTime();
+    plan.Execute(re.data(), im.data());
+    timePoint end = NowTime();
+    std::chrono::duration<double> duration = end - start;
+    simd_Speed[kernel] = duration.count();
+}
+
+void Timing::test_batch(const c_vector input, u_int count)
+{
+    u_int N = input.size();
+    c_vector block;
+    block.reserve(static_cast<size_t>(N) * count);
+    for(u_int m = 0; m < count; ++m)
+    {
+        block.insert(block.end(), input.begin(), input.end());
+    }
+
+    // one thread, then every core, same plan and same data
+    BatchFFT single(N, 1);
+    c_vector data = block;
+    timePoint start = NowTime();
+    single.Execute(data.data(), count);
+    timePoint end = NowTime();
+    std::chrono::duration<double> duration = end - start;
+    batchSingle_Throughput = count / duration.count();
+
+    BatchFFT batch(N);
+    data = block;
+    start = NowTime();
+    batch.Execute(data.data(), count);
+    end = NowTime();
+    duration = end - start;
+    batch_Throughput = count / duration.count();
+    batch_Threads = batch.Threads();
+}
+
 void Timing::TestPrint()
 {
     u_int N = 1024;
@@ -231,20 +343,564 @@ void Timing::TestPrint()
     outfile << "Direct DFT:          " << dft_Speed << " seconds\n";
     outfile << "Recursive FFT:       " << fftRecursive_Speed << " seconds\n";
     outfile << "Non-Recursive FFT:   " << fftInPlace_Speed << " seconds\n";
+    for(int radix = Radix2; radix <= SplitRadix; ++radix)
+    {
+        outfile << "  Plan " << std::left << std::setw(13)
+        << (string(RadixName(static_cast<Radix>(radix))) + ":")
+        << std::right << radix_Speed[radix] << " seconds\n";
+    }
+    outfile << "  Stockham:          " << stockham_Speed << " seconds\n";
+    for(int kernel = ScalarKernel; kernel <= AVX512Kernel; ++kernel)
+    {
+        outfile << "  Split " << std::left << std::setw(12)
+        << (string(KernelName(static_cast<Kernel>(kernel))) + ":")
+        << std::right;
+        if(simd_Speed[kernel] > 0.0) outfile << simd_Speed[kernel] << " seconds\n";
+        else outfile << "not supported on this CPU\n";
+    }
+    outfile << "Batched FFT (1 thread):   " << std::setprecision(0)
+    << batchSingle_Throughput << " transforms/second\n";
+    outfile << "Batched FFT (" << batch_Threads << " threads): "
+    << batch_Throughput << " transforms/second\n";
+    outfile << std::setprecision(6);
     outfile << "\n";
-    double speedup0 = 100*(dft_Speed / fftRecursive_Speed);
-    double speedup1 = 100*(fftRecursive_Speed / fftInPlace_Speed);
+    // ratios of run times, not percentages
+    double speedup0 = dft_Speed / fftRecursive_Speed;
+    double speedup1 = fftRecursive_Speed / fftInPlace_Speed;
 
     outfile << "Speedups:\n";
     outfile << "=============================\n";
-    outfile << "Recursive Fast Fourier Transform is " << std::setprecision(2) << speedup0 << "% faster than a direct DFT\n";
-    outfile << "In place FFT with leveraging bit shifting is " << std::setprecision(2) << speedup1 << "% faster than the Recusive FFT\n";
+    outfile << "Recursive Fast Fourier Transform is " << std::setprecision(2) << speedup0 << "x faster than a direct DFT\n";
+    outfile << "In place FFT with leveraging bit shifting is " << std::setprecision(2) << speedup1 << "x faster than the Recursive FFT\n";
+    outfile << "Stockham autosort FFT is " << std::setprecision(2) << radix_Speed[Radix2] / stockham_Speed
+    << "x the speed of the radix-2 plan (no bit-reversal pass)\n";
+    for(int kernel = AVX2Kernel; kernel <= AVX512Kernel; ++kernel)
+    {
+        if(simd_Speed[kernel] <= 0.0) continue;
+        outfile << KernelName(static_cast<Kernel>(kernel)) << " split-layout FFT is "
+        << std::setprecision(2) << radix_Speed[Radix2] / simd_Speed[kernel]
+        << "x the speed of the scalar radix-2 plan\n";
+    }
 
     outfile.close();
 }
 
+// Keeps a copy of *data as it is now; the returned call puts it back
+template<typename Vector>
+std::function<void()> Restore(const std::shared_ptr<Vector>& data)
+{
+    auto pristine = std::make_shared<Vector>(*data);
+    return [data, pristine]() { std::copy(pristine->begin(), pristine->end(), data->begin()); };
+}
+
+// Every kernel the --bench sweep knows about. Plans and buffers
+// are built in the setup lambdas, outside the timed calls.
+void AddBenchKernels(Benchmark& bench)
+{
+    // O(N^2): past 4096 points a single run takes seconds
+    bench.Add("dft", [](u_int N, const c_vector& input)
+    {
+        auto dft = std::make_shared<DFT>(N, input);
+        return BenchCall{[dft]() { dft->Execute(); }, nullptr};
+    }, 1u << 12);
+
+    bench.Add("recursive", [](u_int N, const c_vector& input)
+    {
+        auto fourier = std::make_shared<FFT>("", N);
+        auto data = std::make_shared<c_vector>(input);
+        auto output = std::make_shared<c_vector>(N);
+        return BenchCall{[fourier, data, output]()
+        {
+            fourier->Execute(*data, *output);
+        }, nullptr};
+    });
+
+    // FFT2::Execute as the CLI runs it, engine kept from the first call
+    bench.Add("inplace", [](u_int N, const c_vector& input)
+    {
+        auto fourier = std::make_shared<FFT2>(N, "");
+        fourier->numbers_ = input;
+        auto pristine = std::make_shared<c_vector>(input);
+        return BenchCall{[fourier]() { fourier->Execute(); }, [fourier, pristine]()
+        {
+            fourier->numbers_ = *pristine;
+        }};
+    });
+
+    // the same choice over the caller's buffer, engine built once
+    bench.Add("engine", [](u_int N, const c_vector& input)
+    {
+        auto engine = std::make_shared<FFTEngine>(N);
+        auto data = std::make_shared<c_vector>(input);
+        return BenchCall{[engine, data]() { engine->Execute(*data); }, Restore(data)};
+    });
+
+    for(int radix = Radix2; radix <= SplitRadix; ++radix)
+    {
+        Radix r = static_cast<Radix>(radix);
+        bench.Add(string("plan-") + RadixName(r), [r](u_int N, const c_vector& input)
+        {
+            auto plan = std::make_shared<FFTPlan>(N, r);
+            auto data = std::make_shared<c_vector>(input);
+            return BenchCall{[plan, data]() { plan->Execute(*data); }, Restore(data)};
+        });
+    }
+
+    // ping-pong buffers, no bit-reversal pass
+    bench.Add("stockham", [](u_int N, const c_vector& input)
+    {
+        auto stockham = std::make_shared<StockhamFFT>(N);
+        auto data = std::make_shared<c_vector>(input);
+        return BenchCall{[stockham, data]() { stockham->Execute(*data); }, Restore(data)};
+    });
+
+    for(int kernel = ScalarKernel; kernel <= AVX512Kernel; ++kernel)
+    {
+        Kernel k = static_cast<Kernel>(kernel);
+        if(!KernelSupported(k)) continue;
+        bench.Add(string("simd-") + KernelName(k), [k](u_int N, const c_vector& input)
+        {
+            auto plan = std::make_shared<SimdPlan>(N, k);
+            auto re = std::make_shared<std::vector<double>>(N);
+            auto im = std::make_shared<std::vector<double>>(N);
+            for(u_int i = 0; i < N; ++i)
+            {
+                (*re)[i] = input[i].real();
+                (*im)[i] = input[i].imag();
+            }
+            auto restoreRe = Restore(re), restoreIm = Restore(im);
+            return BenchCall{[plan, re, im]()
+            {
+                plan->Execute(re->data(), im->data());
+            }, [restoreRe, restoreIm]()
+            {
+                restoreRe();
+                restoreIm();
+            }};
+        });
+    }
+
+    // single precision: same butterflies on half the bytes
+    for(int radix = Radix2; radix <= SplitRadix; ++radix)
+    {
+        Radix r = static_cast<Radix>(radix);
+        bench.Add(string("plan-") + RadixName(r) + "-float", [r](u_int N, const c_vector& input)
+        {
+            auto plan = std::make_shared<FFTPlanF>(N, r);
+            auto data = std::make_shared<f_vector>(input.begin(), input.end());
+            return BenchCall{[plan, data]() { plan->Execute(*data); }, Restore(data)};
+        });
+    }
+
+    // an eighth of the inputs nonzero / an eighth of the bins wanted
+    bench.Add("pruned-in/8", [](u_int N, const c_vector& input)
+    {
+        auto pruned = std::make_shared<PrunedFFT>(N, std::max(1u, N / 8), 0, N);
+        auto data = std::make_shared<c_vector>(input);
+        auto output = std::make_shared<c_vector>(N);
+        return BenchCall{[pruned, data, output]()
+        {
+            pruned->Execute(data->data(), output->data());
+        }, nullptr};
+    });
+
+    bench.Add("pruned-out/8", [](u_int N, const c_vector& input)
+    {
+        auto pruned = std::make_shared<PrunedFFT>(N, N, 0, std::max(1u, N / 8));
+        auto data = std::make_shared<c_vector>(input);
+        auto output = std::make_shared<c_vector>(pruned->Bins());
+        return BenchCall{[pruned, data, output]()
+        {
+            pruned->Execute(data->data(), output->data());
+        }, nullptr};
+    });
+
+    // four tones: bins read by the search, not N (dense below ~400)
+    bench.Add("sparse-4", [](u_int N, const c_vector&)
+    {
+        auto sparse = std::make_shared<SparseFFT>(N, 4);
+        auto data = std::make_shared<c_vector>(N, complex(0.0, 0.0));
+        const u_int tones[] = {1, N / 8 + 3, N / 3, N / 2 + 5};
+        for(u_int i = 0; i < 4; ++i)
+        {
+            for(u_int n = 0; n < N; ++n)
+            {
+                (*data)[n] += std::polar(1.0 + i, 2.0 * M_PI * ((static_cast<size_t>(tones[i]) * n) % N) / N);
+            }
+        }
+        return BenchCall{[sparse, data]() { sparse->Execute(data->data()); }, nullptr};
+    });
+
+    bench.Add("fourstep", [](u_int N, const c_vector& input)
+    {
+        auto fourStep = std::make_shared<FourStepFFT>(N);
+        auto data = std::make_shared<c_vector>(input);
+        return BenchCall{[fourStep, data]() { fourStep->Execute(*data); }, Restore(data)};
+    });
+
+    // N real samples: half the work of a complex transform
+    bench.Add("real", [](u_int N, const c_vector& input)
+    {
+        auto real = std::make_shared<RealFFT>(N);
+        auto samples = std::make_shared<std::vector<double>>(N);
+        auto bins = std::make_shared<c_vector>(real->Bins());
+        for(u_int i = 0; i < N; ++i) (*samples)[i] = input[i].real();
+        return BenchCall{[real, samples, bins]()
+        {
+            real->Forward(samples->data(), bins->data());
+        }, nullptr};
+    }, 0, 0.5);
+
+    // circular convolution with a precomputed filter spectrum: two
+    // transforms per call, with and without the permutation passes
+    bench.Add("conv-permuted", [](u_int N, const c_vector& input)
+    {
+        auto plan = std::make_shared<FFTPlan>(N);
+        auto filter = std::make_shared<c_vector>(input);
+        plan->Execute(*filter);
+        auto data = std::make_shared<c_vector>(input);
+        return BenchCall{[plan, filter, data, N]()
+        {
+            c_vector& x = *data;
+            plan->Execute(x);
+            for(u_int i = 0; i < N; ++i) x[i] = std::conj(x[i] * (*filter)[i]);
+            plan->Execute(x);
+            double scale = 1.0 / N;
+            for(u_int i = 0; i < N; ++i) x[i] = std::conj(x[i]) * scale;
+        }, Restore(data)};
+    }, 0, 2.0);
+
+    bench.Add("conv-bitrev", [](u_int N, const c_vector& input)
+    {
+        auto convolution = std::make_shared<Convolution>(N, input);
+        auto data = std::make_shared<c_vector>(input);
+        return BenchCall{[convolution, data]() { convolution->Execute(*data); }, Restore(data)};
+    }, 0, 2.0);
+
+    // Many short vectors, one thread, figures per transform: the
+    // batch-fft / batch-matrix crossover is where MatrixDFT stops paying
+    const u_int batchRows = 256;
+    bench.Add("batch-fft", [batchRows](u_int N, const c_vector& input)
+    {
+        auto batch = std::make_shared<BatchFFT>(N, 1);
+        auto block = std::make_shared<c_vector>();
+        for(u_int row = 0; row < batchRows; ++row) block->insert(block->end(), input.begin(), input.end());
+        return BenchCall{[batch, block]() { batch->Execute(*block); }, Restore(block)};
+    }, 1u << 10, 1.0, batchRows);
+
+    bench.Add("batch-matrix", [batchRows](u_int N, const c_vector& input)
+    {
+        auto matrix = std::make_shared<MatrixDFT>(N, 1);
+        auto block = std::make_shared<c_vector>();
+        for(u_int row = 0; row < batchRows; ++row) block->insert(block->end(), input.begin(), input.end());
+        return BenchCall{[matrix, block]() { matrix->Execute(*block); }, Restore(block)};
+    }, 1u << 8, 1.0, batchRows);
+}
+
+// A single-precision kernel seen through the double harness: values
+// are rounded to float on the way in and widened on the way out
+AccuracyTransform FloatTransform(u_int N, std::function<void(f_vector&)> forward)
+{
+    auto values = std::make_shared<f_vector>(N);
+    AccuracyTransform transform;
+    transform.forward = [values, forward, N](complex* data)
+    {
+        std::copy(data, data + N, values->begin());
+        forward(*values);
+        std::copy(values->begin(), values->end(), data);
+    };
+    return transform;
+}
+
+// Every transform the --accuracy harness checks
+void AddAccuracyKernels(AccuracyCheck& check)
+{
+    check.Add("recursive", [](u_int N)
+    {
+        auto fourier = std::make_shared<FFT>("", N);
+        auto input = std::make_shared<c_vector>(N);
+        AccuracyTransform transform;
+        transform.forward = [fourier, input, N](complex* data)
+        {
+            std::copy(data, data + N, input->begin());
+            c_vector output(N);
+            fourier->Execute(*input, output);
+            std::copy(output.begin(), output.end(), data);
+        };
+        return transform;
+    });
+
+    // FFT2::Execute picks the plan, four-step or any-size path by N
+    check.Add("inplace", [](u_int N)
+    {
+        auto fourier = std::make_shared<FFT2>(N, "");
+        AccuracyTransform transform;
+        transform.forward = [fourier, N](complex* data)
+        {
+            fourier->numbers_.assign(data, data + N);
+            fourier->Execute();
+            std::copy(fourier->numbers_.begin(), fourier->numbers_.end(), data);
+        };
+        return transform;
+    }, true);
+
+    // every other value of an interleaved buffer, e.g. one of two channels
+    check.Add("engine-stride2", [](u_int N)
+    {
+        auto engine = std::make_shared<FFTEngine>(N);
+        auto interleaved = std::make_shared<c_vector>(2 * static_cast<size_t>(N));
+        AccuracyTransform transform;
+        transform.forward = [engine, interleaved, N](complex* data)
+        {
+            for(u_int i = 0; i < N; ++i) (*interleaved)[2 * i + 1] = data[i];
+            engine->Execute(interleaved->data() + 1, 2);
+            for(u_int i = 0; i < N; ++i) data[i] = (*interleaved)[2 * i + 1];
+        };
+        return transform;
+    }, true);
+
+    for(int radix = Radix2; radix <= SplitRadix; ++radix)
+    {
+        Radix r = static_cast<Radix>(radix);
+        check.Add(string("plan-") + RadixName(r), [r](u_int N)
+        {
+            auto plan = std::make_shared<FFTPlan>(N, r);
+            AccuracyTransform transform;
+            transform.forward = [plan](complex* data) { plan->Execute(data); };
+            return transform;
+        });
+    }
+
+    check.Add("stockham", [](u_int N)
+    {
+        auto stockham = std::make_shared<StockhamFFT>(N);
+        AccuracyTransform transform;
+        transform.forward = [stockham](complex* data) { stockham->Execute(data); };
+        return transform;
+    });
+
+    for(int kernel = ScalarKernel; kernel <= AVX512Kernel; ++kernel)
+    {
+        Kernel k = static_cast<Kernel>(kernel);
+        if(!KernelSupported(k)) continue;
+        check.Add(string("simd-") + KernelName(k), [k](u_int N)
+        {
+            auto plan = std::make_shared<SimdPlan>(N, k);
+            AccuracyTransform transform;
+            transform.forward = [plan](complex* data) { plan->Execute(data); };
+            return transform;
+        });
+    }
+
+    // the full spectrum from four pruned transforms: each half of
+    // the input (N/2 nonzero values) to each half of the bins,
+    //     X[k] = A[k] + (-1)^k B[k]
+    // with A, B the DFTs of the first and second half zero padded
+    check.Add("pruned", [](u_int N)
+    {
+        u_int half = N / 2;
+        auto low = std::make_shared<PrunedFFT>(N, half, 0, half);
+        auto high = std::make_shared<PrunedFFT>(N, half, half, half);
+        auto output = std::make_shared<c_vector>(half);
+        AccuracyTransform transform;
+        transform.forward = [low, high, output, half](complex* data)
+        {
+            c_vector spectrum(2 * static_cast<size_t>(half), complex(0.0, 0.0));
+            for(u_int part = 0; part < 2; ++part)
+            {
+                const complex* input = data + part * half;
+                for(u_int band = 0; band < 2; ++band)
+                {
+                    (band ? high : low)->Execute(input, output->data());
+                    for(u_int k = 0; k < half; ++k)
+                    {
+                        u_int bin = band * half + k;
+                        spectrum[bin] += (part && (bin & 1)) ? -(*output)[k] : (*output)[k];
+                    }
+                }
+            }
+            std::copy(spectrum.begin(), spectrum.end(), data);
+        };
+        return transform;
+    });
+
+    check.Add("fourstep", [](u_int N)
+    {
+        auto fourStep = std::make_shared<FourStepFFT>(N);
+        AccuracyTransform transform;
+        transform.forward = [fourStep](complex* data) { fourStep->Execute(data); };
+        return transform;
+    });
+
+    check.Add("anysize", [](u_int N)
+    {
+        auto any = std::make_shared<AnySizeFFT>(N);
+        AccuracyTransform transform;
+        transform.forward = [any](complex* data) { any->Execute(data); };
+        return transform;
+    }, true);
+
+    // bins 0..N/2 from RealFFT, the rest filled in as conj(X[N-k])
+    check.Add("real", [](u_int N)
+    {
+        auto real = std::make_shared<RealFFT>(N);
+        AccuracyTransform transform;
+        transform.forward = [real, N](complex* data)
+        {
+            std::vector<double> samples(N);
+            c_vector bins(real->Bins());
+            for(u_int n = 0; n < N; ++n) samples[n] = data[n].real();
+            real->Forward(samples.data(), bins.data());
+            for(u_int k = 0; k <= N / 2; ++k) data[k] = bins[k];
+            for(u_int k = N / 2 + 1; k < N; ++k) data[k] = std::conj(bins[N - k]);
+        };
+        transform.inverse = [real, N](complex* data)
+        {
+            std::vector<double> samples(N);
+            real->Inverse(data, samples.data());
+            for(u_int n = 0; n < N; ++n) data[n] = samples[n];
+        };
+        return transform;
+    }, false, true);
+
+    // DIF forward / DIT inverse in bit-reversed order, permuted here
+    // only so the harness can compare in natural order
+    check.Add("dif-bitrev", [](u_int N)
+    {
+        auto plan = std::make_shared<FFTPlan>(N);
+        auto permute = std::make_shared<BitReversal>(N);
+        AccuracyTransform transform;
+        transform.forward = [plan, permute](complex* data)
+        {
+            plan->ForwardBitReversed(data);
+            permute->Execute(data);
+        };
+        transform.inverse = [plan, permute](complex* data)
+        {
+            permute->Execute(data);
+            plan->InverseBitReversed(data);
+        };
+        return transform;
+    });
+
+    // a 64 KB budget forces many panels per pass from N = 2^10 up
+    check.Add("outofcore", [](u_int N)
+    {
+        auto outOfCore = std::make_shared<OutOfCoreFFT>(N, 1u << 16, 1);
+        AccuracyTransform transform;
+        transform.forward = [outOfCore, N](complex* data)
+        {
+            c_vector input(data, data + N);
+            outOfCore->Execute(input.data(), data);
+        };
+        return transform;
+    });
+
+    // one row through the packed matrix; O(N^2) memory, so short N only
+    check.Add("matrix", [](u_int N)
+    {
+        auto matrix = std::make_shared<MatrixDFT>(N, 1);
+        AccuracyTransform transform;
+        transform.forward = [matrix](complex* data) { matrix->Execute(data, 1); };
+        return transform;
+    }, true, false, 1u << 10);
+
+    // single precision, bounds from float epsilon
+    check.Add("recursive-float", [](u_int N)
+    {
+        auto fourier = std::make_shared<FFTF>("", N);
+        auto output = std::make_shared<f_vector>(N);
+        return FloatTransform(N, [fourier, output](f_vector& data)
+        {
+            fourier->Execute(data, *output);
+            data.swap(*output);
+        });
+    }, false, false, 0, floatEpsilon);
+
+    check.Add("inplace-float", [](u_int N)
+    {
+        auto fourier = std::make_shared<FFT2F>(N, "");
+        return FloatTransform(N, [fourier](f_vector& data)
+        {
+            fourier->numbers_.swap(data);
+            fourier->Execute();
+            fourier->numbers_.swap(data);
+        });
+    }, true, false, 0, floatEpsilon);
+
+    for(int radix = Radix2; radix <= SplitRadix; ++radix)
+    {
+        Radix r = static_cast<Radix>(radix);
+        check.Add(string("plan-") + RadixName(r) + "-float", [r](u_int N)
+        {
+            auto plan = std::make_shared<FFTPlanF>(N, r);
+            return FloatTransform(N, [plan](f_vector& data) { plan->Execute(data); });
+        }, false, false, 0, floatEpsilon);
+    }
+}
+
+// Text "re im" lines to stdout, or binary .cvec when outFile is set
+int WriteResult(const c_vector& values, const string& outFile)
+{
+    if (!outFile.empty()) {
+        if (!WriteComplexBinary(outFile, values.data(), values.size())) {
+            std::cerr << "Error writing file " << outFile << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+    ComplexWriter writer;
+    for (const auto& c : values)
+    {
+        writer.Plain(c);
+    }
+    return 0;
+}
+
+// single precision results are widened for output
+int WriteResult(const f_vector& values, const string& outFile)
+{
+    return WriteResult(c_vector(values.begin(), values.end()), outFile);
+}
+
 int main(int argc, char* argv[])
 {
+    // --out <file> in any mode: write the spectrum as binary .cvec
+    // instead of text ("-" for stdout)
+    // --wisdom <file> in any mode: kernel choices from --tune
+    // (default fft2.wisdom in the working directory, if present)
+    // --float in FFT and --dft mode: single-precision transform
+    string outFile;
+    string wisdomFile = defaultWisdomFile;
+    bool wisdomGiven = false;
+    bool single = false;
+    std::vector<char*> args;
+    for (int i = 0; i < argc; ++i) {
+        if (string(argv[i]) == "--out" && i + 1 < argc) {
+            outFile = argv[++i];
+            continue;
+        }
+        if (string(argv[i]) == "--wisdom" && i + 1 < argc) {
+            wisdomFile = argv[++i];
+            wisdomGiven = true;
+            continue;
+        }
+        if (string(argv[i]) == "--float") {
+            single = true;
+            continue;
+        }
+        args.push_back(argv[i]);
+    }
+    argc = static_cast<int>(args.size());
+    argv = args.data();
+
+    bool tuning = argc >= 2 && string(argv[1]) == "--tune";
+    if (!SharedWisdom().Load(wisdomFile) && wisdomGiven && !tuning) {
+        std::cerr << "Error: cannot load wisdom file " << wisdomFile
+        << " (missing, malformed or tuned on another machine)" << std::endl;
+        return 1;
+    }
+
     // TIMING MODE: ./bin/fft2 --timing
     if (argc == 2 && string(argv[1]) == "--timing") {
         std::cout << "Running timing tests with N=1024..." << std::endl;
@@ -271,6 +927,33 @@ int main(int argc, char* argv[])
         timer.test_fftIP(vec);
         std::cout << "  Non-Recursive FFT complete: " << timer.fftInPlace_Speed << " seconds" << std::endl;
 
+        for(int radix = Radix2; radix <= SplitRadix; ++radix)
+        {
+            Radix r = static_cast<Radix>(radix);
+            timer.test_radix(r, vec);
+            std::cout << "  Plan " << RadixName(r) << " complete: " << timer.radix_Speed[r] << " seconds" << std::endl;
+        }
+
+        std::cout << "Testing Stockham autosort FFT..." << std::endl;
+        timer.test_stockham(vec);
+        std::cout << "  Stockham complete: " << timer.stockham_Speed << " seconds ("
+        << timer.radix_Speed[Radix2] / timer.stockham_Speed << "x radix-2 plan)" << std::endl;
+
+        std::cout << "Testing split-layout SIMD FFT (best here: " << KernelName(BestKernel()) << ")..." << std::endl;
+        for(int kernel = ScalarKernel; kernel <= AVX512Kernel; ++kernel)
+        {
+            Kernel k = static_cast<Kernel>(kernel);
+            timer.test_simd(k, vec);
+            if(timer.simd_Speed[k] <= 0.0) continue;
+            std::cout << "  " << KernelName(k) << " complete: " << timer.simd_Speed[k] << " seconds ("
+            << timer.radix_Speed[Radix2] / timer.simd_Speed[k] << "x scalar)" << std::endl;
+        }
+
+        std::cout << "Testing batched FFT (1000 transforms)..." << std::endl;
+        timer.test_batch(vec, 1000);
+        std::cout << "  1 thread: " << timer.batchSingle_Throughput << " transforms/second" << std::endl;
+        std::cout << "  " << timer.batch_Threads << " threads: " << timer.batch_Throughput << " transforms/second" << std::endl;
+
         std::cout << "\nWriting results to timing.txt..." << std::endl;
         timer.TestPrint();
         std::cout << "Done!" << std::endl;
@@ -278,25 +961,350 @@ int main(int argc, char* argv[])
         return 0;
     }
 
-    // FFT MODE: ./bin/fft2 <N> <input_file>
-    if (argc != 3) {
-        std::cerr << "Usage: " << argv[0] << " <N> <input_file>" << std::endl;
+    // BENCHMARK MODE: ./bin/fft2 --bench [minLog2 maxLog2] [--csv file] [--json file]
+    // sweeps N = 2^minLog2 .. 2^maxLog2 (default 2^4 .. 2^24) over every kernel
+    if (argc >= 2 && string(argv[1]) == "--bench") {
+        u_int minLog2 = 4, maxLog2 = 24;
+        string csvFile, jsonFile;
+        std::vector<u_int> range;
+        for (int i = 2; i < argc; ++i) {
+            string arg = argv[i];
+            if (arg == "--csv" && i + 1 < argc) csvFile = argv[++i];
+            else if (arg == "--json" && i + 1 < argc) jsonFile = argv[++i];
+            else range.push_back(std::atoi(argv[i]));
+        }
+        if (range.size() == 2) {
+            minLog2 = range[0];
+            maxLog2 = range[1];
+        }
+        if (range.size() == 1 || range.size() > 2 || minLog2 < 1 || minLog2 > maxLog2 || maxLog2 > 26) {
+            std::cerr << "Error: expected --bench [minLog2 maxLog2] with 1 <= minLog2 <= maxLog2 <= 26" << std::endl;
+            return 1;
+        }
+
+        Benchmark bench(minLog2, maxLog2);
+        AddBenchKernels(bench);
+        bench.Run(std::cout);
+        if (!csvFile.empty() && !bench.WriteCSV(csvFile)) {
+            std::cerr << "Error writing file " << csvFile << std::endl;
+            return 1;
+        }
+        if (!jsonFile.empty() && !bench.WriteJSON(jsonFile)) {
+            std::cerr << "Error writing file " << jsonFile << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // ACCURACY MODE: ./bin/fft2 --accuracy [maxLog2]
+    // every kernel against a long double DFT (N <= 4096) or its own
+    // inverse (larger N), exit status 1 if anything is flagged
+    if (argc >= 2 && argc <= 3 && string(argv[1]) == "--accuracy") {
+        u_int maxLog2 = (argc == 3) ? std::atoi(argv[2]) : 20;
+        if (maxLog2 < 1 || maxLog2 > 26) {
+            std::cerr << "Error: expected --accuracy [maxLog2] with 1 <= maxLog2 <= 26" << std::endl;
+            return 1;
+        }
+        AccuracyCheck check(maxLog2);
+        AddAccuracyKernels(check);
+        return check.Run(std::cout) ? 1 : 0;
+    }
+
+    // TUNE MODE: ./bin/fft2 --tune [minLog2 maxLog2]
+    // times every candidate kernel for N = 2^minLog2 .. 2^maxLog2
+    // (default 2^4 .. 2^20) and saves the fastest per N to the
+    // wisdom file, which later runs load at startup
+    if (tuning) {
+        u_int minLog2 = (argc == 4) ? std::atoi(argv[2]) : 4;
+        u_int maxLog2 = (argc == 4) ? std::atoi(argv[3]) : 20;
+        if ((argc != 2 && argc != 4) || minLog2 < 1 || minLog2 > maxLog2 || maxLog2 > 26) {
+            std::cerr << "Error: expected --tune [minLog2 maxLog2] with 1 <= minLog2 <= maxLog2 <= 26" << std::endl;
+            return 1;
+        }
+        std::cout << std::left << std::setw(18) << "kernel" << std::right
+        << std::setw(10) << "N" << std::setw(14) << "median ns" << std::endl;
+        for (u_int log2 = minLog2; log2 <= maxLog2; ++log2) {
+            const WisdomEntry& best = SharedWisdom().Tune(1u << log2, &std::cout);
+            std::cout << "  -> " << best.kernel << std::endl;
+        }
+        if (!SharedWisdom().Save(wisdomFile)) {
+            std::cerr << "Error writing file " << wisdomFile << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote " << SharedWisdom().Count() << " sizes to " << wisdomFile << std::endl;
+        return 0;
+    }
+
+    // REAL MODE: ./bin/fft2 --real <N> <input_file>
+    // real parts only, prints bins 0..N/2
+    if (argc == 4 && string(argv[1]) == "--real") {
+        u_int N = std::atoi(argv[2]);
+        FFT2 fourier(N, argv[3]);
+        fourier.Read();
+        if(fourier.Verify()) return 1;
+        if(N < 2 || !fourier.isPowerTwo(N)) {
+            std::cerr << "Error: N must be a power of 2, at least 2, for a real FFT" << std::endl;
+            return 1;
+        }
+
+        std::vector<double> samples(N);
+        for(u_int i = 0; i < N; ++i) samples[i] = fourier.numbers_[i].real();
+        RealFFT real(N);
+        c_vector bins(real.Bins());
+        real.Forward(samples.data(), bins.data());
+        if (WriteResult(bins, outFile)) return 1;
+        return 0;
+    }
+
+    // BATCH MODE: ./bin/fft2 --batch <N> <input_file> [matrix]
+    // file holds M signals of N values back to back; "matrix" runs
+    // them as one blocked matrix multiply (any N, fastest for N <= 16)
+    if ((argc == 4 || argc == 5) && string(argv[1]) == "--batch") {
+        u_int N = std::atoi(argv[2]);
+        bool matrix = (argc == 5);
+        if (matrix && string(argv[4]) != "matrix") {
+            std::cerr << "Error: Unknown batch mode " << argv[4] << " (expected matrix)" << std::endl;
+            return 1;
+        }
+        FFT2 fourier(N, argv[3]);
+        fourier.Read();
+        if (matrix ? N == 0 : !fourier.isPowerTwo(N)) {
+            std::cerr << (matrix ? "Error: N must be positive" : "Error: N must be a positive power of 2") << std::endl;
+            return 1;
+        }
+        if (fourier.numbers_.empty() || fourier.numbers_.size() % N != 0) {
+            std::cerr << "Error: Expected a multiple of " << N << " complex numbers, got " << fourier.numbers_.size() << std::endl;
+            return 1;
+        }
+
+        if (matrix) {
+            MatrixDFT(N).Execute(fourier.numbers_);
+        } else {
+            BatchFFT batch(N);
+            batch.Execute(fourier.numbers_);
+        }
+        if (WriteResult(fourier.numbers_, outFile)) return 1;
+        return 0;
+    }
+
+    // PRUNED MODE: ./bin/fft2 --pruned <N> <input_file> [firstBin bins]
+    // the file holds the nonzero head of an N-point frame (zero padded
+    // up to N); prints bins firstBin.. (all N by default)
+    if ((argc == 4 || argc == 6) && string(argv[1]) == "--pruned") {
+        u_int N = std::atoi(argv[2]);
+        c_vector values = ReadComplexFile(argv[3]);
+        if (N == 0 || (N & (N - 1)) != 0) {
+            std::cerr << "Error: N must be a positive power of 2" << std::endl;
+            return 1;
+        }
+        if (values.empty() || values.size() > N) {
+            std::cerr << "Error: Expected 1 to " << N << " complex numbers, got " << values.size() << std::endl;
+            return 1;
+        }
+        u_int firstBin = (argc == 6) ? std::atoi(argv[4]) : 0;
+        u_int bins = (argc == 6) ? std::atoi(argv[5]) : N;
+        if (bins == 0 || bins > N) {
+            std::cerr << "Error: bins must be 1 to " << N << std::endl;
+            return 1;
+        }
+
+        PrunedFFT pruned(N, values.size(), firstBin, bins);
+        c_vector output(bins);
+        pruned.Execute(values.data(), output.data());
+        if (WriteResult(output, outFile)) return 1;
+        return 0;
+    }
+
+    // SPARSE MODE: ./bin/fft2 --sparse <N> <input_file> <k> [tolerance]
+    // the k largest bins as "bin re im" lines, from 12k samples per
+    // round instead of N; --out writes all N bins, zero outside
+    // those k. Exit status 1 if the signal is not k-sparse
+    if ((argc == 5 || argc == 6) && string(argv[1]) == "--sparse") {
+        u_int N = std::atoi(argv[2]);
+        FFT2 fourier(N, argv[3]);
+        fourier.Read();
+        if(fourier.Verify()) return 1;
+        if (!fourier.isPowerTwo(N)) {
+            std::cerr << "Error: N must be a power of 2 for a sparse FFT" << std::endl;
+            return 1;
+        }
+        u_int k = std::atoi(argv[4]);
+        double tolerance = (argc == 6) ? std::atof(argv[5]) : sparseTolerance;
+        if (k == 0 || k > N || !(tolerance > 0.0)) {
+            std::cerr << "Error: expected 1 <= k <= " << N << " and a positive tolerance" << std::endl;
+            return 1;
+        }
+
+        SparseFFT sparse(N, k, tolerance);
+        bool isSparse = sparse.Execute(fourier.numbers_.data());
+        if (outFile.empty()) {
+            std::cout << std::setprecision(17);
+            for (const SparseBin& bin : sparse.Bins()) {
+                std::cout << bin.bin << " " << bin.value.real() << " " << bin.value.imag() << "\n";
+            }
+            std::cout.flush();
+        } else {
+            c_vector spectrum(N, complex(0.0, 0.0));
+            for (const SparseBin& bin : sparse.Bins()) spectrum[bin.bin] = bin.value;
+            if (WriteResult(spectrum, outFile)) return 1;
+            std::cout << sparse.Bins().size() << " bins from " << sparse.Samples() << " of " << N << " samples, "
+            << (sparse.Dense() ? "dense FFT" : "sparse search") << ", residual " << sparse.Residual() << std::endl;
+        }
+        if (!isSparse) {
+            std::cerr << "Error: signal is not " << k << "-sparse: " << sparse.Residual()
+            << " of its energy lies outside the " << k << " largest bins (tolerance " << tolerance
+            << "); bins are from a dense FFT" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // CONVERT MODE: ./bin/fft2 --convert <input_file> <output.cvec>
+    // rewrites a text (or binary) input as a binary .cvec file
+    if (argc == 4 && string(argv[1]) == "--convert") {
+        c_vector values = ReadComplexFile(argv[2]);
+        if (values.empty()) {
+            std::cerr << "Error: no complex numbers read from " << argv[2] << std::endl;
+            return 1;
+        }
+        if (!WriteComplexBinary(argv[3], values.data(), values.size())) {
+            std::cerr << "Error writing file " << argv[3] << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // CONVOLVE MODE: ./bin/fft2 --convolve <file_a> <file_b>
+    // linear convolution, La + Lb - 1 values, through bit-reversed spectra
+    if (argc == 4 && string(argv[1]) == "--convolve") {
+        c_vector a = ReadComplexFile(argv[2]);
+        c_vector b = ReadComplexFile(argv[3]);
+        if (a.empty() || b.empty()) {
+            std::cerr << "Error: no complex numbers read from " << (a.empty() ? argv[2] : argv[3]) << std::endl;
+            return 1;
+        }
+        if (WriteResult(Convolve(a, b), outFile)) return 1;
+        return 0;
+    }
+
+    // OUT-OF-CORE MODE: ./bin/fft2 --outofcore <input.cvec> <output.cvec> [budgetMB]
+    // panels of the mapped input, never more than about budgetMB resident
+    if ((argc == 4 || argc == 5) && string(argv[1]) == "--outofcore") {
+        ComplexFileView input(argv[2]);
+        if (!input.IsOpen()) {
+            std::cerr << "Error: " << argv[2] << " is not a binary .cvec file (see --convert)" << std::endl;
+            return 1;
+        }
+        size_t N = input.Count();
+        if (N < 2 || (N & (N - 1)) != 0) {
+            std::cerr << "Error: N must be a power of 2, at least 2, got " << N << std::endl;
+            return 1;
+        }
+        size_t budgetMB = (argc == 5) ? std::strtoull(argv[4], nullptr, 10) : 256;
+        OutOfCoreFFT fourier(N, budgetMB << 20);
+        if (!fourier.Fits()) {
+            std::cerr << "Error: a budget of " << budgetMB << " MB cannot hold one column; need at least "
+            << (fourier.MinBudget() >> 20) + 1 << " MB" << std::endl;
+            return 1;
+        }
+        ComplexFileOutput output(argv[3], N);
+        if (!output.IsOpen()) {
+            std::cerr << "Error writing file " << argv[3] << std::endl;
+            return 1;
+        }
+
+        fourier.Execute(input.Values(), output.Values(), true);
+        std::cout << "N = " << N << " (" << fourier.Rows() << " x " << fourier.Columns() << "), panels of "
+        << fourier.PanelColumns(0) << " / " << fourier.PanelColumns(1) << " columns, budget "
+        << budgetMB << " MB, peak RSS " << (PeakResidentBytes() >> 20) << " MB" << std::endl;
+        return 0;
+    }
+
+    // DFT MODE: ./bin/fft2 --dft <N> <input_file> [threads]
+    // O(N^2) reference through the twiddle table, on every core by default
+    if ((argc == 4 || argc == 5) && string(argv[1]) == "--dft") {
+        u_int N = std::atoi(argv[2]);
+        FFT2 fourier(N, argv[3]);
+        fourier.Read();
+        if(fourier.Verify()) return 1;
+        u_int threads = (argc == 5) ? std::atoi(argv[4]) : 0;
+
+        if (single) {
+            DFTF dft(N, f_vector(fourier.numbers_.begin(), fourier.numbers_.end()));
+            dft.ExecuteTable(threads);
+            return WriteResult(dft.Result(), outFile) ? 1 : 0;
+        }
+        DFT dft(N, fourier.numbers_);
+        dft.ExecuteTable(threads);
+        if (WriteResult(dft.Result(), outFile)) return 1;
+        return 0;
+    }
+
+    // FFT MODE: ./bin/fft2 <N> <input_file> [radix]
+    if (argc != 3 && argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " <N> <input_file> [radix2|radix4|split|stockham]" << std::endl;
+        std::cerr << "       " << argv[0] << " --real <N> <input_file>" << std::endl;
+        std::cerr << "       " << argv[0] << " --batch <N> <input_file> [matrix]" << std::endl;
+        std::cerr << "       " << argv[0] << " --dft <N> <input_file> [threads]" << std::endl;
+        std::cerr << "       " << argv[0] << " --pruned <N> <input_file> [firstBin bins]" << std::endl;
+        std::cerr << "       " << argv[0] << " --sparse <N> <input_file> <k> [tolerance]" << std::endl;
+        std::cerr << "       " << argv[0] << " --outofcore <input.cvec> <output.cvec> [budgetMB]" << std::endl;
+        std::cerr << "       " << argv[0] << " --convolve <file_a> <file_b>" << std::endl;
+        std::cerr << "       " << argv[0] << " --convert <input_file> <output.cvec>" << std::endl;
         std::cerr << "       " << argv[0] << " --timing" << std::endl;
-        std::cerr << "  N: number of samples (must be power of 2)" << std::endl;
-        std::cerr << "  input_file: file containing N complex numbers (format: real imag per line)" << std::endl;
+        std::cerr << "       " << argv[0] << " --bench [minLog2 maxLog2] [--csv file] [--json file]" << std::endl;
+        std::cerr << "       " << argv[0] << " --accuracy [maxLog2]" << std::endl;
+        std::cerr << "       " << argv[0] << " --tune [minLog2 maxLog2]" << std::endl;
+        std::cerr << "  --out <file.cvec>: write the result as binary instead of text (- for stdout)" << std::endl;
+        std::cerr << "  N: number of samples (any N; powers of 2 are fastest)" << std::endl;
+        std::cerr << "  input_file: file containing N complex numbers (text \"real imag\" per line, or binary .cvec)" << std::endl;
+        std::cerr << "  --float: single-precision transform (FFT and --dft modes)" << std::endl;
+        std::cerr << "  --wisdom <file>: kernel choices saved by --tune (default " << defaultWisdomFile << ")" << std::endl;
+        std::cerr << "  radix: butterfly kernel (default radix2, or the tuned kernel if N has wisdom);" << std::endl;
+        std::cerr << "         stockham: autosort FFT over two buffers, no bit-reversal pass" << std::endl;
         return 1;
     }
 
+    Radix radix = Radix2;
+    bool stockham = false;
+    if (argc == 4) {
+        string name = argv[3];
+        if (name == "radix4") radix = Radix4;
+        else if (name == "split") radix = SplitRadix;
+        else if (name == "stockham") stockham = true;
+        else if (name != "radix2") {
+            std::cerr << "Error: unknown radix " << name << std::endl;
+            return 1;
+        }
+    }
+
     u_int N = std::atoi(argv[1]);
-    FFT2 fourier(N, argv[2]);
+    if (single) {
+        if (stockham) {
+            std::cerr << "Error: the Stockham FFT has no single-precision version" << std::endl;
+            return 1;
+        }
+        FFT2F fourier(N, argv[2], radix);
+        fourier.Read();
+        if(fourier.Verify()) return 1;
+        fourier.Execute();
+        return WriteResult(fourier.numbers_, outFile) ? 1 : 0;
+    }
+
+    FFT2 fourier(N, argv[2], radix);
     fourier.Read();
     if(fourier.Verify()) return 1;
 
-    fourier.Execute();
-    for (const auto& c : fourier.numbers_)
-    {
-        std::cout << c.real() << " " << c.imag() << std::endl;
+    if (stockham) {
+        if (!fourier.isPowerTwo(N)) {
+            std::cerr << "Error: N must be a power of 2 for the Stockham FFT" << std::endl;
+            return 1;
+        }
+        StockhamFFT(N).Execute(fourier.numbers_);
+    } else {
+        fourier.Execute();
     }
+    if (WriteResult(fourier.numbers_, outFile)) return 1;
 
     return 0;
 }
@@ -9,10 +9,28 @@ using string = std::string;
 using complex = std::complex<double>;
 #include <iomanip>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <vector>
 using c_vector = std::vector<complex>;
 using u_vector = std::vector<unsigned int>;
+#include "plan.h"
+#include "simd.h"
+#include "stockham.h"
+#include "realfft.h"
+#include "batch.h"
+#include "matrixdft.h"
+#include "fourstep.h"
+#include "outofcore.h"
+#include "anysize.h"
+#include "convolution.h"
+#include "pruned.h"
+#include "sparse.h"
+#include "wisdom.h"
+#include "engine.h"
+#include "bench.h"
+#include "accuracy.h"
+#include "complex_io.h"
 
 
 
@@ -23,49 +41,54 @@ c_vector Read(string filename, u_int num);
 
 c_vector fft_InPlace(c_vector& data);
 
-class FFT2 
+/*
+    FFT2, FFT and DFT are templated on the scalar type Real:
+        FFT2  / FFT  / DFT      double (the default everywhere)
+        FFT2F / FFTF / DFTF     float: half the memory per value,
+                                enough for 16-bit audio
+    Input files are read as double and rounded once; twiddles are
+    worked out in double and rounded once, the arithmetic is Real.
+*/
+template<typename Real>
+class BasicFFT2 
 {
+public:
+    using Complex = std::complex<Real>;
+    using Vector = std::vector<Complex>;
+
 public: // Vars
     u_int size_;
     string filename_;
-    c_vector numbers_;
+    Vector numbers_;
+    Radix radix_;
+
+private:
+    // built by the first Execute, rebuilt only if size_ or radix_
+    // has changed since; the engine for double (and widened float
+    // any-size), the plan for float powers of two
+    std::shared_ptr<FFTEngine> engine_;
+    std::shared_ptr<BasicFFTPlan<Real>> plan_;
+    u_int planSize_;
+    Radix planRadix_;
     
 public:
-    FFT2(u_int _size, string _filename)
-    : size_(_size) , filename_(_filename) 
+    BasicFFT2(u_int _size, string _filename, Radix _radix = Radix2)
+    : size_(_size) , filename_(_filename), radix_(_radix)
+    , planSize_(0), planRadix_(_radix)
     {}
 
     void Read()
     {
-        string line;
-        std::ifstream file(filename_);
-        //c_vector numbers;
-
-        if(!file.is_open())
-        {
-            std::cerr << "Error opening file " << filename_ << std::endl;
-            return;  
-        }
-        while(std::getline(file, line))
-        {
-            if (line.empty()) continue;        
-            double real, imag;
-            std::istringstream stream(line);
-            // confirm input is in complex form (double, double)
-            if(stream >> real >> imag) 
-            {
-                complex num(real, imag);
-                numbers_.emplace_back(num);
-            }
-        }
-        file.close();
+        c_vector values = ReadComplexFile(filename_);
+        numbers_.assign(values.begin(), values.end());
     }
     
     int Verify()
     {
-        if (!isPowerTwo(size_)) 
+        // any N > 0, non powers of two go through AnySizeFFT
+        if (size_ == 0) 
         {
-            std::cerr << "Error: N must be a positive power of 2" << std::endl;
+            std::cerr << "Error: N must be positive" << std::endl;
             return 1;
         }
         if(numbers_.size() !=
@@ -137,12 +160,19 @@ public: // Bit reversal
 
 };
 
-class FFT
+using FFT2 = BasicFFT2<double>;
+using FFT2F = BasicFFT2<float>;
+
+template<typename Real>
+class BasicFFT
 {
 public:
-    FFT(string _filename, int _size)
+    using Complex = std::complex<Real>;
+    using Vector = std::vector<Complex>;
+
+    BasicFFT(string _filename, int _size)
     : filename_(_filename), size_(_size)
-    , numbers_(c_vector()), result_(c_vector())
+    , numbers_(Vector()), result_(Vector())
     {}
     void Read();
     //   X[k] = Σ(even indices) + Σ(odd indices)
@@ -151,32 +181,55 @@ public:
     // X[k] = E[k] + W_N^k * O[k]
     // X[k + N/2] = E[k] - W_N^k * O[k]
         // W_N^(k + N/2) = W_N^k * W_N^(N/2) = W_N^k * (-1) = -W_N^k
-    c_vector Execute(c_vector input);
+    Vector Execute(Vector input);
+    // Same result as Execute, without allocating once output
+    // holds input.size() values (it is resized to that)
+    void Execute(const Vector& input, Vector& output);
     void Print();
     string filename_;
     int size_;
-    c_vector numbers_;
-    c_vector result_;
+    Vector numbers_;
+    Vector result_;
+
+private:
+    // N-point FFT of input[0], input[stride], input[2*stride], ...
+    // written contiguously to output[0..N-1]
+    void ExecuteStrided(const Complex* input, Complex* output, int N, int stride);
 };
 
-class DFT
+using FFT = BasicFFT<double>;
+using FFTF = BasicFFT<float>;
+
+template<typename Real>
+class BasicDFT
 {
 public:
-    DFT(u_int _size, c_vector _vec)
+    using Complex = std::complex<Real>;
+    using Vector = std::vector<Complex>;
+
+    BasicDFT(u_int _size, Vector _vec)
     : size_(_size), vec1_(_vec)
     {
-        result_ = c_vector(size_, 0);
+        result_ = Vector(size_, 0);
     }
 
     void Execute();
+    // Same transform as an oracle for large N: twiddles come from one
+    // N-entry table indexed by (k*n) mod N instead of cos/sin per term,
+    // and the frequency loop is split across threads (0 = every core)
+    void ExecuteTable(u_int threads = 0);
     void Print();
+    const Vector& Result() const { return result_; }
 private:    
     u_int size_;
-    c_vector vec1_;
-    c_vector result_;
+    Vector vec1_;
+    Vector result_;
 
 };
 
+using DFT = BasicDFT<double>;
+using DFTF = BasicDFT<float>;
+
 #include <chrono>
 using timePoint = std::chrono::_V2::system_clock::time_point;
 class Timing
@@ -185,6 +238,16 @@ public:
     double dft_Speed = 0.0;
     double fftRecursive_Speed = 0.0;
     double fftInPlace_Speed = 0.0;
+    // plan execute only, indexed by Radix
+    double radix_Speed[3] = {0.0, 0.0, 0.0};
+    // ping-pong autosort execute only
+    double stockham_Speed = 0.0;
+    // split-layout execute only, indexed by Kernel (0 = not supported)
+    double simd_Speed[3] = {0.0, 0.0, 0.0};
+    // transforms per second through BatchFFT
+    double batch_Throughput = 0.0;
+    double batchSingle_Throughput = 0.0;
+    u_int batch_Threads = 0;
     c_vector vector_;
 
 public:
@@ -197,31 +260,16 @@ public:
     
     void test_dft(u_int size, const c_vector vector);
     void test_fftRec(const c_vector input);
-    void test_fftIP(const c_vector input);
+    void test_fftIP(c_vector input);
+    void test_radix(Radix radix, const c_vector input);
+    void test_stockham(const c_vector input);
+    void test_simd(Kernel kernel, const c_vector input);
+    void test_batch(const c_vector input, u_int count);
     void TestPrint();
 
     void Read(string filename)
     {
-        string line;
-        std::ifstream file(filename);
-        if(!file.is_open())
-        {
-            std::cerr << "Error opening file " << filename << std::endl;
-            return;  
-        }
-        while(std::getline(file, line))
-        {
-            if (line.empty()) continue;        
-            double real, imag;
-            std::istringstream stream(line);
-            // confirm input is in complex form (double, double)
-            if(stream >> real >> imag) 
-            {
-                complex num(real, imag);
-                vector_.emplace_back(num);
-            }
-        }
-        file.close();
+        vector_ = ReadComplexFile(filename);
     }
     
 
@@ -0,0 +1,86 @@
+#include "fourstep.h"
+#include <algorithm>
+
+namespace
+{
+    // 32 x 32 complex doubles = 16 KB per tile
+    const u_int tileSize = 32;
+
+    u_int Log2(u_int N)
+    {
+        u_int numBits = 0;
+        while(N > 1)
+        {
+            N >>= 1;
+            ++numBits;
+        }
+        return numBits;
+    }
+}
+
+FourStepFFT::FourStepFFT(u_int _size, u_int _threads)
+: size_(_size)
+, rows_(1u << (Log2(_size) / 2))
+, cols_(_size / (1u << (Log2(_size) / 2)))
+, rowPlan_(rows_), colPlan_(cols_)
+, twiddles_(_size), scratch_(_size), pool_(_threads)
+{}
+
+void FourStepFFT::Execute(complex* data)
+{
+    complex* scratch = scratch_.data();
+    // 1. N1 x N2 -> N2 x N1
+    Transpose(data, scratch, rows_, cols_, false);
+    // 2. N1-point FFT on each of the N2 rows
+    RowFFTs(scratch, scratch, cols_, rowPlan_);
+    // 3. twiddle, N2 x N1 -> N1 x N2
+    Transpose(scratch, data, cols_, rows_, true);
+    // 4. N2-point FFT on each of the N1 rows, into the scratch
+    RowFFTs(data, scratch, rows_, colPlan_);
+    // 5. N1 x N2 -> N2 x N1 back into data, X in natural order
+    Transpose(scratch, data, rows_, cols_, false);
+}
+
+void FourStepFFT::Transpose(const complex* src, complex* dst,
+    u_int rows, u_int cols, bool twiddle)
+{
+    u_int tileRows = (rows + tileSize - 1) / tileSize;
+    pool_.ParallelFor(tileRows, [=](u_int begin, u_int end)
+    {
+        for(u_int tile = begin; tile < end; ++tile)
+        {
+            u_int r0 = tile * tileSize;
+            u_int r1 = std::min(rows, r0 + tileSize);
+            for(u_int c0 = 0; c0 < cols; c0 += tileSize)
+            {
+                u_int c1 = std::min(cols, c0 + tileSize);
+                for(u_int r = r0; r < r1; ++r)
+                {
+                    const complex* in = src + static_cast<size_t>(r) * cols;
+                    for(u_int c = c0; c < c1; ++c)
+                    {
+                        complex value = in[c];
+                        // row r = n2, column c = k1
+                        if(twiddle) value *= twiddles_.At(static_cast<size_t>(r) * c);
+                        dst[static_cast<size_t>(c) * rows + r] = value;
+                    }
+                }
+            }
+        }
+    });
+}
+
+void FourStepFFT::RowFFTs(const complex* src, complex* dst, u_int rows, const FFTPlan& plan)
+{
+    u_int length = plan.Size();
+    pool_.ParallelFor(rows, [=, &plan](u_int begin, u_int end)
+    {
+        for(u_int row = begin; row < end; ++row)
+        {
+            size_t offset = static_cast<size_t>(row) * length;
+            // the row is in cache for the FFT right after the copy
+            if(src != dst) std::copy(src + offset, src + offset + length, dst + offset);
+            plan.Execute(dst + offset);
+        }
+    });
+}
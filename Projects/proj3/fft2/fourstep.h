@@ -0,0 +1,61 @@
+#ifndef FOURSTEP_H
+#define FOURSTEP_H
+
+#include "plan.h"
+#include "threadpool.h"
+#include "twiddle.h"
+
+// Sizes from here up go through FourStepFFT in FFT2::Execute
+const u_int fourStepMinSize = 1u << 22;
+
+/*
+    Six-step ("four-step" plus explicit transposes) FFT for very
+    large N. Split N = N1 * N2 and index
+        n = N2*n1 + n2        k = k1 + N1*k2
+    so that
+        X[k1 + N1 k2] = Σ_n2 W_N2^(n2 k2) W_N^(n2 k1) Σ_n1 x[N2 n1 + n2] W_N1^(n1 k1)
+    Steps, with x viewed as an N1 x N2 matrix:
+        1. transpose              (N2 rows of N1)
+        2. N1-point FFT per row
+        3. multiply by W_N^(n2 k1) and transpose back (N1 rows of N2)
+        4. N2-point FFT per row, into the scratch
+        5. transpose into data    -> natural order
+    Each sub-FFT is about sqrt(N) long and fits in cache, every
+    pass walks memory row by row, and rows and transpose tiles are
+    spread across the pool's threads. The W_N^(n2 k1) of step 3
+    come from SplitTwiddles, two sqrt(N)-entry tables, so the only
+    N-sized buffer next to the data is the scratch.
+*/
+class FourStepFFT
+{
+public:
+    // _threads = 0 -> one per hardware core
+    FourStepFFT(u_int _size, u_int _threads = 0);
+
+    // In place, through one N-value scratch buffer: five passes
+    // over the data, the last one landing back in data
+    void Execute(complex* data);
+    void Execute(c_vector& data) { Execute(data.data()); }
+
+    u_int Size() const { return size_; }
+    u_int Threads() const { return pool_.Threads(); }
+
+private:
+    // dst (cols x rows) = src (rows x cols) transposed,
+    // optionally scaled by W_N^(row * col)
+    void Transpose(const complex* src, complex* dst,
+        u_int rows, u_int cols, bool twiddle);
+    // rows of plan.Size() from src, transformed in dst (may be src)
+    void RowFFTs(const complex* src, complex* dst, u_int rows, const FFTPlan& plan);
+
+    u_int size_;
+    u_int rows_;    // N1
+    u_int cols_;    // N2
+    FFTPlan rowPlan_;
+    FFTPlan colPlan_;
+    SplitTwiddles twiddles_;
+    c_vector scratch_;
+    ThreadPool pool_;
+};
+
+#endif // FOURSTEP_H
@@ -0,0 +1,229 @@
+#include "matrixdft.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MATRIXDFT_X86 1
+#endif
+
+namespace
+{
+    // Rows of X per register tile
+    const u_int tileRows = 4;
+
+    // y[r][0..width) = Σ_i x[r][i] * panel[i][0..width) for r < 4
+    void TileScalar(const double* x, u_int depth, const double* panel,
+        double* const* y)
+    {
+        const u_int width = 8;
+        double acc[tileRows][width] = {};
+        for(u_int i = 0; i < depth; ++i)
+        {
+            const double* m = panel + i * width;
+            for(u_int r = 0; r < tileRows; ++r)
+            {
+                double value = x[r * depth + i];
+                for(u_int j = 0; j < width; ++j) acc[r][j] += value * m[j];
+            }
+        }
+        for(u_int r = 0; r < tileRows; ++r)
+        {
+            std::copy(acc[r], acc[r] + width, y[r]);
+        }
+    }
+
+#ifdef MATRIXDFT_X86
+    // 4 rows x 8 columns in 8 registers
+    __attribute__((target("avx2,fma")))
+    void TileAVX2(const double* x, u_int depth, const double* panel,
+        double* const* y)
+    {
+        const double* x0 = x;
+        const double* x1 = x + depth;
+        const double* x2 = x + 2 * depth;
+        const double* x3 = x + 3 * depth;
+        __m256d a00 = _mm256_setzero_pd(), a01 = _mm256_setzero_pd();
+        __m256d a10 = _mm256_setzero_pd(), a11 = _mm256_setzero_pd();
+        __m256d a20 = _mm256_setzero_pd(), a21 = _mm256_setzero_pd();
+        __m256d a30 = _mm256_setzero_pd(), a31 = _mm256_setzero_pd();
+        for(u_int i = 0; i < depth; ++i)
+        {
+            __m256d m0 = _mm256_loadu_pd(panel + i * 8);
+            __m256d m1 = _mm256_loadu_pd(panel + i * 8 + 4);
+            __m256d b = _mm256_broadcast_sd(x0 + i);
+            a00 = _mm256_fmadd_pd(b, m0, a00);
+            a01 = _mm256_fmadd_pd(b, m1, a01);
+            b = _mm256_broadcast_sd(x1 + i);
+            a10 = _mm256_fmadd_pd(b, m0, a10);
+            a11 = _mm256_fmadd_pd(b, m1, a11);
+            b = _mm256_broadcast_sd(x2 + i);
+            a20 = _mm256_fmadd_pd(b, m0, a20);
+            a21 = _mm256_fmadd_pd(b, m1, a21);
+            b = _mm256_broadcast_sd(x3 + i);
+            a30 = _mm256_fmadd_pd(b, m0, a30);
+            a31 = _mm256_fmadd_pd(b, m1, a31);
+        }
+        _mm256_storeu_pd(y[0], a00); _mm256_storeu_pd(y[0] + 4, a01);
+        _mm256_storeu_pd(y[1], a10); _mm256_storeu_pd(y[1] + 4, a11);
+        _mm256_storeu_pd(y[2], a20); _mm256_storeu_pd(y[2] + 4, a21);
+        _mm256_storeu_pd(y[3], a30); _mm256_storeu_pd(y[3] + 4, a31);
+    }
+
+    // 4 rows x 16 columns in 8 registers
+    __attribute__((target("avx512f")))
+    void TileAVX512(const double* x, u_int depth, const double* panel,
+        double* const* y)
+    {
+        const double* x0 = x;
+        const double* x1 = x + depth;
+        const double* x2 = x + 2 * depth;
+        const double* x3 = x + 3 * depth;
+        __m512d a00 = _mm512_setzero_pd(), a01 = _mm512_setzero_pd();
+        __m512d a10 = _mm512_setzero_pd(), a11 = _mm512_setzero_pd();
+        __m512d a20 = _mm512_setzero_pd(), a21 = _mm512_setzero_pd();
+        __m512d a30 = _mm512_setzero_pd(), a31 = _mm512_setzero_pd();
+        for(u_int i = 0; i < depth; ++i)
+        {
+            __m512d m0 = _mm512_loadu_pd(panel + i * 16);
+            __m512d m1 = _mm512_loadu_pd(panel + i * 16 + 8);
+            __m512d b = _mm512_set1_pd(x0[i]);
+            a00 = _mm512_fmadd_pd(b, m0, a00);
+            a01 = _mm512_fmadd_pd(b, m1, a01);
+            b = _mm512_set1_pd(x1[i]);
+            a10 = _mm512_fmadd_pd(b, m0, a10);
+            a11 = _mm512_fmadd_pd(b, m1, a11);
+            b = _mm512_set1_pd(x2[i]);
+            a20 = _mm512_fmadd_pd(b, m0, a20);
+            a21 = _mm512_fmadd_pd(b, m1, a21);
+            b = _mm512_set1_pd(x3[i]);
+            a30 = _mm512_fmadd_pd(b, m0, a30);
+            a31 = _mm512_fmadd_pd(b, m1, a31);
+        }
+        _mm512_storeu_pd(y[0], a00); _mm512_storeu_pd(y[0] + 8, a01);
+        _mm512_storeu_pd(y[1], a10); _mm512_storeu_pd(y[1] + 8, a11);
+        _mm512_storeu_pd(y[2], a20); _mm512_storeu_pd(y[2] + 8, a21);
+        _mm512_storeu_pd(y[3], a30); _mm512_storeu_pd(y[3] + 8, a31);
+    }
+#endif
+}
+
+MatrixDFT::MatrixDFT(u_int _size, u_int _threads, Kernel _kernel)
+: size_(_size), kernel_(_kernel), pool_(_threads)
+{
+    if(!KernelSupported(kernel_)) kernel_ = BestKernel();
+    panelWidth_ = (kernel_ == AVX512Kernel) ? 16 : 8;
+
+    u_int N = size_;
+    u_int depth = 2 * N;
+    panels_ = (depth + panelWidth_ - 1) / panelWidth_;
+
+    // W_N^j for j < N; W^(nk) = W^((nk) mod N), exact for every entry
+    std::vector<double> cosine(N), sine(N);
+    for(u_int j = 0; j < N; ++j)
+    {
+        double angle = -2.0 * M_PI * j / N;
+        cosine[j] = cos(angle);
+        sine[j] = sin(angle);
+    }
+
+    matrix_.assign(static_cast<size_t>(panels_) * depth * panelWidth_, 0.0);
+    for(u_int n = 0; n < N; ++n)
+    {
+        for(u_int k = 0; k < N; ++k)
+        {
+            u_int j = static_cast<u_int>((static_cast<unsigned long long>(n) * k) % N);
+            double c = cosine[j], s = sine[j];
+            // rows 2n (times xr) and 2n+1 (times xi), columns 2k (yr) and 2k+1 (yi)
+            const double entries[2][2] = {{c, s}, {-s, c}};
+            for(u_int a = 0; a < 2; ++a)
+            {
+                for(u_int b = 0; b < 2; ++b)
+                {
+                    u_int row = 2 * n + a, column = 2 * k + b;
+                    u_int panel = column / panelWidth_;
+                    size_t offset = (static_cast<size_t>(panel) * depth + row) * panelWidth_
+                        + column % panelWidth_;
+                    matrix_[offset] = entries[a][b];
+                }
+            }
+        }
+    }
+
+    // packed rows, then one panel's worth of output for edges
+    size_t scratch = static_cast<size_t>(tileRows) * (depth + panelWidth_);
+    scratch_.assign(pool_.Threads(), std::vector<double>(scratch));
+}
+
+void MatrixDFT::Execute(const complex* input, complex* output, u_int count)
+{
+    u_int tiles = (count + tileRows - 1) / tileRows;
+    const double* source = reinterpret_cast<const double*>(input);
+    double* destination = reinterpret_cast<double*>(output);
+
+    // one contiguous run of tiles per scratch slot, so no two
+    // threads ever share one
+    u_int parts = std::min(static_cast<u_int>(scratch_.size()), tiles);
+    pool_.ParallelFor(parts, [&](u_int begin, u_int end)
+    {
+        for(u_int part = begin; part < end; ++part)
+        {
+            u_int first = static_cast<u_int>(static_cast<size_t>(tiles) * part / parts);
+            u_int last = static_cast<u_int>(static_cast<size_t>(tiles) * (part + 1) / parts);
+            Tiles(source, destination, count, first, last, scratch_[part].data());
+        }
+    });
+}
+
+void MatrixDFT::Tiles(const double* source, double* destination, u_int count,
+    u_int begin, u_int end, double* scratch) const
+{
+    u_int depth = 2 * size_;
+    double* tile = scratch;
+    double* edge = scratch + static_cast<size_t>(tileRows) * depth;
+    for(u_int t = begin; t < end; ++t)
+    {
+        u_int first = t * tileRows;
+        u_int rows = std::min(tileRows, count - first);
+        std::copy(source + static_cast<size_t>(first) * depth,
+            source + static_cast<size_t>(first + rows) * depth, tile);
+        std::fill(tile + static_cast<size_t>(rows) * depth, tile + static_cast<size_t>(tileRows) * depth, 0.0);
+
+        for(u_int p = 0; p < panels_; ++p)
+        {
+            u_int column = p * panelWidth_;
+            u_int width = std::min(panelWidth_, depth - column);
+            bool direct = rows == tileRows && width == panelWidth_;
+            double* y[tileRows];
+            for(u_int r = 0; r < tileRows; ++r)
+            {
+                y[r] = direct ? destination + static_cast<size_t>(first + r) * depth + column
+                    : edge + r * panelWidth_;
+            }
+
+            const double* panel = matrix_.data() + static_cast<size_t>(p) * depth * panelWidth_;
+            switch(kernel_)
+            {
+#ifdef MATRIXDFT_X86
+                case AVX2Kernel: TileAVX2(tile, depth, panel, y); break;
+                case AVX512Kernel: TileAVX512(tile, depth, panel, y); break;
+#endif
+                default: TileScalar(tile, depth, panel, y); break;
+            }
+
+            if(!direct)
+            {
+                for(u_int r = 0; r < rows; ++r)
+                {
+                    std::copy(y[r], y[r] + width,
+                        destination + static_cast<size_t>(first + r) * depth + column);
+                }
+            }
+        }
+    }
+}
+
+void MatrixDFT::Execute(c_vector& block)
+{
+    Execute(block.data(), static_cast<u_int>(block.size() / size_));
+}
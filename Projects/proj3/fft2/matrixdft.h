@@ -0,0 +1,68 @@
+#ifndef MATRIXDFT_H
+#define MATRIXDFT_H
+
+#include "plan.h"
+#include "simd.h"
+#include "threadpool.h"
+
+/*
+    Many short same-size DFTs as one matrix multiply.
+    With the batch as a count x N matrix X (row m = signal m),
+        Y = X W        W[n][k] = W_N^(nk)
+    W is symmetric, so row m of Y is the DFT of row m of X.
+    Viewing each interleaved complex row as 2N doubles turns the
+    complex product into a real one with no reordering:
+        [yr yi] += xr [ c  s]      W_N^(nk) = c + i s
+                   + xi [-s  c]
+    so Y (count x 2N) = X (count x 2N) M (2N x 2N), 8N^2 flops per
+    transform against about 5 N log2 N for an FFT, but every flop
+    is a fused multiply-add on a full vector with no shuffles, no
+    bit reversal and no per-call setup. For N up to about 16 that
+    wins; the benchmark's batch-* rows show where the FFT takes over.
+
+    Blocking, as in a GEMM:
+        M is packed once into column panels of panelWidth doubles
+        (8 for scalar/AVX2, 16 for AVX-512), each panel 2N rows deep
+        and contiguous, zero padded past column 2N
+        rows of X are copied 4 at a time into a contiguous tile
+        (which also makes in-place batches safe)
+        a 4 x panelWidth block of Y is held in registers while the
+        tile and one panel stream past, then stored once
+    For N <= 16 all of M is at most 8 KB and stays in L1 with the
+    tile; row tiles are spread across the pool's threads, one run
+    of tiles and one preallocated tile buffer per thread.
+*/
+class MatrixDFT
+{
+public:
+    // _threads = 0 -> one per hardware core; falls back to
+    // BestKernel() if _kernel is not supported here
+    MatrixDFT(u_int _size, u_int _threads = 0, Kernel _kernel = BestKernel());
+
+    // count rows of Size() values, output may equal input
+    void Execute(const complex* input, complex* output, u_int count);
+    // In place on count rows
+    void Execute(complex* block, u_int count) { Execute(block, block, count); }
+    void Execute(c_vector& block);
+
+    u_int Size() const { return size_; }
+    u_int Threads() const { return pool_.Threads(); }
+    Kernel GetKernel() const { return kernel_; }
+
+private:
+    // row tiles [begin, end) of count rows, scratch from scratch_
+    void Tiles(const double* source, double* destination, u_int count,
+        u_int begin, u_int end, double* scratch) const;
+
+    u_int size_;
+    Kernel kernel_;
+    u_int panelWidth_;
+    u_int panels_;
+    // panel p, row i, column j at (p * 2N + i) * panelWidth_ + j
+    std::vector<double> matrix_;
+    ThreadPool pool_;
+    // one tile and edge buffer per thread, reused by every call
+    std::vector<std::vector<double>> scratch_;
+};
+
+#endif // MATRIXDFT_H
@@ -0,0 +1,203 @@
+#include "outofcore.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+    // rows per gather block: the panel is written 8 values at a time
+    const u_int gatherRows = 8;
+
+    u_int Log2(size_t n)
+    {
+        u_int bits = 0;
+        while((size_t(1) << bits) < n) ++bits;
+        return bits;
+    }
+
+    // N1 = 2^floor(log2(N)/2), the shorter side
+    u_int RowCount(size_t N)
+    {
+        return 1u << (Log2(N) / 2);
+    }
+
+    // largest power of two <= limit, 0 if limit is 0
+    u_int PowerBelow(size_t limit)
+    {
+        if(limit == 0) return 0;
+        u_int power = 1;
+        while(2 * static_cast<size_t>(power) <= limit) power <<= 1;
+        return power;
+    }
+
+    // a read fault may map a whole aligned fault-around window (64 KB
+    // by default) of cached pages, not just the page it needs, and a
+    // run that straddles two windows maps both
+    const size_t faultAround = 64 * 1024;
+
+    // panel[p * height + r] = source[r * stride + p] for p < width, first <= r < last
+    void Gather(const complex* source, size_t stride, complex* panel,
+        u_int width, u_int height, u_int first, u_int last)
+    {
+        for(u_int r0 = first; r0 < last; r0 += gatherRows)
+        {
+            u_int rows = std::min(gatherRows, last - r0);
+            for(u_int p = 0; p < width; ++p)
+            {
+                complex* to = panel + static_cast<size_t>(p) * height + r0;
+                for(u_int r = 0; r < rows; ++r) to[r] = source[(r0 + r) * stride + p];
+            }
+        }
+    }
+
+    // the inverse of Gather
+    void Scatter(const complex* panel, complex* destination, size_t stride,
+        u_int width, u_int height, u_int first, u_int last)
+    {
+        for(u_int r0 = first; r0 < last; r0 += gatherRows)
+        {
+            u_int rows = std::min(gatherRows, last - r0);
+            for(u_int p = 0; p < width; ++p)
+            {
+                const complex* from = panel + static_cast<size_t>(p) * height + r0;
+                for(u_int r = 0; r < rows; ++r) destination[(r0 + r) * stride + p] = from[r];
+            }
+        }
+    }
+}
+
+OutOfCoreFFT::OutOfCoreFFT(size_t _size, size_t _budget, u_int _threads)
+: size_(_size), budget_(_budget)
+, rows_(RowCount(_size)), cols_(static_cast<u_int>(_size / RowCount(_size)))
+, columnPlan_(rows_), rowPlan_(cols_)
+, twiddles_(_size)
+, pool_(_threads)
+{
+    size_t panelBytes = budget_ / 2;
+    panelColumns_[0] = std::min(cols_, PowerBelow(panelBytes / (sizeof(complex) * rows_)));
+    panelColumns_[1] = std::min(rows_, PowerBelow(panelBytes / (sizeof(complex) * cols_)));
+}
+
+size_t OutOfCoreFFT::MinBudget() const
+{
+    return 2 * sizeof(complex) * std::max(rows_, cols_);
+}
+
+void OutOfCoreFFT::Advise(const void* begin, size_t bytes, int advice) const
+{
+    // whole pages covering [begin, begin + bytes)
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t first = reinterpret_cast<uintptr_t>(begin) & ~(page - 1);
+    uintptr_t last = (reinterpret_cast<uintptr_t>(begin) + bytes + page - 1) & ~(page - 1);
+    madvise(reinterpret_cast<void*>(first), last - first, advice);
+}
+
+void OutOfCoreFFT::Execute(const complex* input, complex* output, bool mapped)
+{
+    if(!Fits()) return;
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t dataBytes = size_ * sizeof(complex);
+    if(mapped)
+    {
+        // no read-ahead: the runs are short and far apart
+        Advise(input, dataBytes, MADV_RANDOM);
+        Advise(output, dataBytes, MADV_RANDOM);
+    }
+    // rows whose runs fit in the page half of the budget; the mapped
+    // rows are dropped after each block of them
+    auto blockRows = [this, page](u_int width)
+    {
+        size_t perRow = (width * sizeof(complex) + page - 1) / page * page + 2 * faultAround;
+        return static_cast<u_int>(std::max<size_t>(1, budget_ / 2 / perRow));
+    };
+
+    // pass 1: N1-point FFTs down the columns of x, twiddle, store transposed
+    u_int width = panelColumns_[0];
+    u_int block = blockRows(width);
+    panel_.resize(static_cast<size_t>(width) * rows_);
+    for(u_int c0 = 0; c0 < cols_; c0 += width)
+    {
+        for(u_int r = 0; r < rows_; r += block)
+        {
+            u_int last = std::min(rows_, r + block);
+            Gather(input + c0, cols_, panel_.data(), width, rows_, r, last);
+            if(mapped)
+            {
+                Advise(input + static_cast<size_t>(r) * cols_,
+                    static_cast<size_t>(last - r) * cols_ * sizeof(complex), MADV_DONTNEED);
+            }
+        }
+        pool_.ParallelFor(width, [this, c0](u_int begin, u_int end)
+        {
+            for(u_int p = begin; p < end; ++p)
+            {
+                complex* column = panel_.data() + static_cast<size_t>(p) * rows_;
+                columnPlan_.Execute(column);
+                size_t n2 = c0 + p;
+                for(u_int k1 = 1; k1 < rows_; ++k1) column[k1] *= twiddles_.At(n2 * k1);
+            }
+        });
+        // one contiguous run, written a page budget at a time
+        complex* run = output + static_cast<size_t>(c0) * rows_;
+        size_t chunk = std::max<size_t>(page, budget_ / 2) / sizeof(complex);
+        for(size_t i = 0; i < panel_.size(); i += chunk)
+        {
+            size_t count = std::min(chunk, panel_.size() - i);
+            std::copy(panel_.begin() + i, panel_.begin() + i + count, run + i);
+            if(mapped) Advise(run + i, count * sizeof(complex), MADV_DONTNEED);
+        }
+    }
+
+    // pass 2: N2-point FFTs down the columns of T, in place
+    width = panelColumns_[1];
+    block = blockRows(width);
+    panel_.assign(static_cast<size_t>(width) * cols_, complex(0.0, 0.0));
+    for(u_int c0 = 0; c0 < rows_; c0 += width)
+    {
+        for(u_int r = 0; r < cols_; r += block)
+        {
+            u_int last = std::min(cols_, r + block);
+            Gather(output + c0, rows_, panel_.data(), width, cols_, r, last);
+            if(mapped)
+            {
+                Advise(output + static_cast<size_t>(r) * rows_,
+                    static_cast<size_t>(last - r) * rows_ * sizeof(complex), MADV_DONTNEED);
+            }
+        }
+        pool_.ParallelFor(width, [this](u_int begin, u_int end)
+        {
+            for(u_int p = begin; p < end; ++p)
+            {
+                rowPlan_.Execute(panel_.data() + static_cast<size_t>(p) * cols_);
+            }
+        });
+        for(u_int r = 0; r < cols_; r += block)
+        {
+            u_int last = std::min(cols_, r + block);
+            Scatter(panel_.data(), output + c0, rows_, width, cols_, r, last);
+            if(mapped)
+            {
+                Advise(output + static_cast<size_t>(r) * rows_,
+                    static_cast<size_t>(last - r) * rows_ * sizeof(complex), MADV_DONTNEED);
+            }
+        }
+    }
+    c_vector().swap(panel_);
+}
+
+size_t PeakResidentBytes()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while(std::getline(status, line))
+    {
+        if(line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return static_cast<size_t>(std::stoull(line.substr(6))) * 1024;
+        }
+    }
+    return 0;
+}
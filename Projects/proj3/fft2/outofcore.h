@@ -0,0 +1,79 @@
+#ifndef OUTOFCORE_H
+#define OUTOFCORE_H
+
+#include <cstddef>
+#include "plan.h"
+#include "threadpool.h"
+#include "twiddle.h"
+
+/*
+    Out-of-core FFT for inputs larger than memory, over mapped
+    .cvec files (complex_io.h). Same index split as FourStepFFT,
+    N = N1 * N2 with
+        n = N2*n1 + n2        k = k1 + N1*k2
+        X[k1 + N1 k2] = Σ_n2 W_N2^(n2 k2) W_N^(n2 k1) Σ_n1 x[N2 n1 + n2] W_N1^(n1 k1)
+    but only a panel of columns is ever in memory:
+        pass 1  input as N1 rows x N2 columns. A panel of P columns
+                is gathered (one P-value run from every row), each
+                column gets its N1-point FFT and the W_N^(n2 k1)
+                twiddles, and the panel is written back transposed:
+                T[n2*N1 + k1], so the write is one contiguous run
+        pass 2  T as N2 rows x N1 columns: panels of columns k1 get
+                their N2-point FFTs over n2 and go back in place,
+                which leaves X[k1 + N1 k2] at T[k2*N1 + k1], natural
+                order with no final transpose
+    Two reads and two writes of the data in all, every access a
+    run of P values. W_N^j comes from SplitTwiddles (twiddle.h),
+    two sqrt(N)-entry tables, so no table is O(N).
+
+    Memory budget: half goes to the panel buffer (P = the largest
+    power of two that fits), half to pages of the mappings. With
+    mapped files, rows are gathered and scattered in blocks whose
+    pages (fault-around included) fit that half, and each block's
+    pages are dropped from the process (MADV_DONTNEED) before the
+    next, so peak RSS stays near the budget. Written pages live on
+    in the page cache and reach the file.
+*/
+class OutOfCoreFFT
+{
+public:
+    // N a power of two; _budget in bytes; _threads = 0 -> one per core
+    OutOfCoreFFT(size_t _size, size_t _budget, u_int _threads = 0);
+
+    // false if half the budget cannot hold one column
+    bool Fits() const { return panelColumns_[0] > 0 && panelColumns_[1] > 0; }
+    // Smallest budget that Fits() for this N
+    size_t MinBudget() const;
+
+    // output = DFT(input); input is only read. With mapped, both
+    // point into file mappings and their pages are released as the
+    // passes go; never set it for heap memory, where dropping a
+    // page zeroes it.
+    void Execute(const complex* input, complex* output, bool mapped = false);
+
+    size_t Size() const { return size_; }
+    u_int Rows() const { return rows_; }
+    u_int Columns() const { return cols_; }
+    // columns per panel in pass 1 and pass 2
+    u_int PanelColumns(u_int pass) const { return panelColumns_[pass]; }
+
+private:
+    // madvise on the pages covering [begin, begin + bytes)
+    void Advise(const void* begin, size_t bytes, int advice) const;
+
+    size_t size_;
+    size_t budget_;
+    u_int rows_;        // N1
+    u_int cols_;        // N2
+    u_int panelColumns_[2];
+    FFTPlan columnPlan_;    // N1 points, pass 1
+    FFTPlan rowPlan_;       // N2 points, pass 2
+    SplitTwiddles twiddles_;
+    c_vector panel_;
+    ThreadPool pool_;
+};
+
+// Peak resident set of this process in bytes (VmHWM), 0 if unknown
+size_t PeakResidentBytes();
+
+#endif // OUTOFCORE_H
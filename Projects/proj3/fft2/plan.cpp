@@ -0,0 +1,271 @@
+#include "plan.h"
+#include "codelets.h"
+#include "complex_math.h"
+
+const char* RadixName(Radix radix)
+{
+    switch(radix)
+    {
+        case Radix4: return "radix-4";
+        case SplitRadix: return "split-radix";
+        default: return "radix-2";
+    }
+}
+
+template<typename Real>
+BasicFFTPlan<Real>::BasicFFTPlan(u_int _size, Radix _radix)
+: size_(_size), radix_(_radix), numBits_(0), permute_(_size)
+{
+    // log2(N)
+    for(u_int n = size_; n > 1; n >>= 1) ++numBits_;
+
+    twiddles_.resize(size_);
+    for(u_int k = 0; k < size_; ++k)
+    {
+        double angle = -2.0 * M_PI * k / size_;
+        twiddles_[k] = Complex(cos(angle), sin(angle));
+    }
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::Execute(Complex* data) const
+{
+    // every kernel is decimation-in-time on bit-reversed input
+    permute_.Execute(data);
+    Stages(data);
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::Stages(Complex* data) const
+{
+    switch(radix_)
+    {
+        case Radix4: Butterflies4(data); break;
+        case SplitRadix: ButterfliesSplit(data, size_); break;
+        default: Butterflies(data, Leaves(data), size_); break;
+    }
+}
+
+/*
+    Radix-4 DIF, the mirror image of Butterflies4. A natural-order
+    block of size 4q with a = x[j], b = x[j+q], c = x[j+2q], d = x[j+3q]
+    and W = W_4q becomes
+        x[j]    = (a + c) + (b + d)
+        x[j+q]  = W^2j ((a + c) - (b + d))
+        x[j+2q] = W^j  ((a - c) - i (b - d))
+        x[j+3q] = W^3j ((a - c) + i (b - d))
+    which is two radix-2 DIF stages at once, so the output ends up
+    in radix-2 bit-reversed order. Stages run from the whole array
+    down to blocks of codeletMaxSize, which finish as unrolled DIF
+    codelets; an odd number of stages above that starts with one
+    radix-2 DIF stage.
+*/
+template<typename Real>
+void BasicFFTPlan<Real>::ForwardBitReversed(Complex* data) const
+{
+    u_int leaf = size_ < codeletMaxSize ? size_ : codeletMaxSize;
+    u_int blockSize = size_;
+    u_int stagesLeft = 0;
+    for(u_int n = size_ / leaf; n > 1; n >>= 1) ++stagesLeft;
+    if(stagesLeft % 2)
+    {
+        // x[i], x[i + N/2] <- a + b, (a - b) W_N^i
+        u_int half = size_ / 2;
+        for(u_int i = 0; i < half; ++i)
+        {
+            Complex a = data[i];
+            Complex b = data[i + half];
+            data[i] = a + b;
+            data[i + half] = Rotate(twiddles_[i], a.real() - b.real(), a.imag() - b.imag());
+        }
+        blockSize = half;
+    }
+    for(; blockSize > leaf; blockSize >>= 2)
+    {
+        u_int q = blockSize / 4;
+        // W_blockSize^j = W_N^(j * stride)
+        u_int stride = size_ / blockSize;
+        for(u_int blockIndex = 0; blockIndex < size_; blockIndex += blockSize)
+        {
+            Complex* a = data + blockIndex;
+            Complex* b = a + q;
+            Complex* c = b + q;
+            Complex* d = c + q;
+            for(u_int j = 0; j < q; ++j)
+            {
+                Complex sum02 = a[j] + c[j];
+                Complex diff02 = a[j] - c[j];
+                Complex sum13 = b[j] + d[j];
+                // -i * (b - d)
+                Complex diff13(b[j].imag() - d[j].imag(), d[j].real() - b[j].real());
+
+                a[j] = sum02 + sum13;
+                b[j] = Rotate(twiddles_[2 * j * stride],
+                    sum02.real() - sum13.real(), sum02.imag() - sum13.imag());
+                c[j] = Rotate(twiddles_[j * stride],
+                    diff02.real() + diff13.real(), diff02.imag() + diff13.imag());
+                d[j] = Rotate(twiddles_[3 * j * stride],
+                    diff02.real() - diff13.real(), diff02.imag() - diff13.imag());
+            }
+        }
+    }
+    for(u_int blockIndex = 0; blockIndex < size_; blockIndex += leaf)
+    {
+        RunDifCodelet(data + blockIndex, leaf);
+    }
+}
+
+template<typename Real>
+void BasicFFTPlan<Real>::InverseBitReversed(Complex* data) const
+{
+    for(u_int i = 0; i < size_; ++i) data[i] = std::conj(data[i]);
+    Stages(data);
+    Real scale = Real(1) / size_;
+    for(u_int i = 0; i < size_; ++i) data[i] = std::conj(data[i]) * scale;
+}
+
+// Run the unrolled codelet on every leaf block (codelets.h).
+// Returns the block size the remaining stages start from.
+template<typename Real>
+u_int BasicFFTPlan<Real>::Leaves(Complex* data) const
+{
+    u_int leaf = size_ < codeletMaxSize ? size_ : codeletMaxSize;
+    for(u_int blockIndex = 0; blockIndex < size_; blockIndex += leaf)
+    {
+        RunCodelet(data + blockIndex, leaf);
+    }
+    return leaf * 2;
+}
+
+// Radix-2 stages for block sizes firstBlock up to lastBlock
+template<typename Real>
+void BasicFFTPlan<Real>::Butterflies(Complex* data, u_int firstBlock, u_int lastBlock) const
+{
+    for(u_int blockSize = firstBlock; blockSize <= lastBlock; blockSize <<= 1)
+    {
+        u_int half = blockSize / 2;
+        // W_blockSize^i = W_N^(i * stride)
+        u_int stride = size_ / blockSize;
+        for(u_int blockIndex = 0; blockIndex < size_; blockIndex += blockSize)
+        {
+            for(u_int i = 0; i < half; ++i)
+            {
+                u_int evenIndex = blockIndex + i;
+                u_int oddIndex = evenIndex + half;
+
+                Complex twiddleOdd = twiddles_[i * stride] * data[oddIndex];
+                Complex even = data[evenIndex];
+                data[evenIndex] = even + twiddleOdd;
+                data[oddIndex] = even - twiddleOdd;
+            }
+        }
+    }
+}
+
+/*
+    Radix-4 DIT on radix-2 bit-reversed input.
+    A block of size 4q holds four q-point DFTs in the order
+        A = x[4n], B = x[4n+2], C = x[4n+1], D = x[4n+3]
+    With W = W_4q and t1 = W^j C, t2 = W^2j B, t3 = W^3j D:
+        X[j]    = A + t1 + t2 + t3
+        X[j+q]  = A - i t1 - t2 + i t3
+        X[j+2q] = A - t1 + t2 - t3
+        X[j+3q] = A + i t1 - t2 - i t3
+    The leaf blocks run as codelets; if an odd number of stages
+    is left after them, one radix-2 stage goes first.
+*/
+template<typename Real>
+void BasicFFTPlan<Real>::Butterflies4(Complex* data) const
+{
+    u_int q = Leaves(data) / 2;
+    u_int stagesLeft = 0;
+    for(u_int n = size_ / q; n > 1; n >>= 1) ++stagesLeft;
+    if(stagesLeft % 2)
+    {
+        q *= 2;
+        Butterflies(data, q, q);
+    }
+    for(; q < size_; q <<= 2)
+    {
+        u_int blockSize = 4 * q;
+        // W_blockSize^j = W_N^(j * stride)
+        u_int stride = size_ / blockSize;
+        for(u_int blockIndex = 0; blockIndex < size_; blockIndex += blockSize)
+        {
+            Complex* a = data + blockIndex;
+            Complex* b = a + q;
+            Complex* c = b + q;
+            Complex* d = c + q;
+            for(u_int j = 0; j < q; ++j)
+            {
+                Complex t0 = a[j];
+                Complex t2 = twiddles_[2 * j * stride] * b[j];
+                Complex t1 = twiddles_[j * stride] * c[j];
+                Complex t3 = twiddles_[3 * j * stride] * d[j];
+
+                Complex sum02 = t0 + t2;
+                Complex diff02 = t0 - t2;
+                Complex sum13 = t1 + t3;
+                // -i * (t1 - t3)
+                Complex diff13(t1.imag() - t3.imag(), t3.real() - t1.real());
+
+                a[j] = sum02 + sum13;
+                b[j] = diff02 + diff13;
+                c[j] = sum02 - sum13;
+                d[j] = diff02 - diff13;
+            }
+        }
+    }
+}
+
+/*
+    Split-radix DIT, depth first on radix-2 bit-reversed input.
+    A block of size n holds, in order,
+        U  = DFT_n/2 of x[2m]      (first half)
+        Z  = DFT_n/4 of x[4m+1]    (third quarter)
+        Z' = DFT_n/4 of x[4m+3]    (last quarter)
+    With W = W_n, s = W^k Z + W^3k Z', d = W^k Z - W^3k Z':
+        X[k]       = U[k] + s
+        X[k+n/2]   = U[k] - s
+        X[k+n/4]   = U[k+n/4] - i d
+        X[k+3n/4]  = U[k+n/4] + i d
+*/
+template<typename Real>
+void BasicFFTPlan<Real>::ButterfliesSplit(Complex* data, u_int n) const
+{
+    // small blocks are straight-line codelets (codelets.h)
+    if(n <= codeletMaxSize)
+    {
+        RunCodelet(data, n);
+        return;
+    }
+    u_int quarter = n / 4;
+    ButterfliesSplit(data, n / 2);
+    ButterfliesSplit(data + 2 * quarter, quarter);
+    ButterfliesSplit(data + 3 * quarter, quarter);
+
+    // W_n^k = W_N^(k * stride)
+    u_int stride = size_ / n;
+    Complex* u0 = data;
+    Complex* u1 = data + quarter;
+    Complex* z = data + 2 * quarter;
+    Complex* z3 = data + 3 * quarter;
+    for(u_int k = 0; k < quarter; ++k)
+    {
+        Complex a = twiddles_[k * stride] * z[k];
+        Complex b = twiddles_[3 * k * stride] * z3[k];
+        Complex sum = a + b;
+        // i * (a - b)
+        Complex diff(b.imag() - a.imag(), a.real() - b.real());
+
+        Complex even = u0[k];
+        Complex evenQ = u1[k];
+        u0[k] = even + sum;
+        z[k] = even - sum;
+        u1[k] = evenQ - diff;
+        z3[k] = evenQ + diff;
+    }
+}
+
+template class BasicFFTPlan<double>;
+template class BasicFFTPlan<float>;
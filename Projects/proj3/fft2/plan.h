@@ -0,0 +1,91 @@
+#ifndef PLAN_H
+#define PLAN_H
+
+#include <cmath>
+#include "../bitrev/permute.h"
+
+// Butterfly kernel run by a plan. All three give the same
+// result (within rounding); they differ in passes and multiplies.
+enum Radix
+{
+    Radix2,     // log2(N) passes, N/2 twiddle multiplies per pass
+    Radix4,     // two radix-2 stages fused: log4(N) passes, 3 multiplies per 4 outputs
+    SplitRadix  // radix-2 on even samples, radix-4 on odd, fewest multiplies
+};
+
+const char* RadixName(Radix radix);
+
+/*
+    Reusable FFT plan.
+    Everything that only depends on N is computed once here,
+    so running many same-size transforms only pays for the butterflies.
+
+    twiddles_[k] = W_N^k = e^(-2πik/N)     (k = 0 to N-1)
+        A block of size m needs W_m^i = W_N^(i * N/m), so every
+        stage indexes the same table with a stride of N/m.
+        Each entry comes straight from cos/sin, no chained
+        multiply, so the error does not build up across a block.
+        Radix-4 and split-radix reach W^3k, hence the full N entries.
+    Blocks of up to codeletMaxSize values run as unrolled codelets
+    with constant twiddles (codelets.h); the table covers the rest.
+    permute_ reorders into bit-reversed order (bitrev/permute.h)
+
+    Convolution pipelines (forward, pointwise multiply, inverse)
+    never need the spectrum in natural order, so the plan also runs
+    both transforms without the permutation:
+        ForwardBitReversed   radix-4 decimation in frequency, natural
+                             order in, bit-reversed order out
+        InverseBitReversed   the plan's DIT stages on bit-reversed
+                             input, natural order out, through
+                             x = conj(F(conj(X))) / N
+    Two spectra in the same scrambled order multiply bin by bin
+    just as well, so a convolution skips both permutation passes.
+
+    Real is the scalar type: double (FFTPlan) or float (FFTPlanF).
+    A float plan moves half the bytes per value; its twiddles are
+    worked out in double and rounded once, so its error stays
+    within a few float epsilons times log2(N) (see accuracy.h).
+*/
+template<typename Real>
+class BasicFFTPlan
+{
+public:
+    using Complex = std::complex<Real>;
+    using Vector = std::vector<Complex>;
+
+    BasicFFTPlan(u_int _size, Radix _radix = Radix2);
+
+    // In-place forward transform of size_ values
+    void Execute(Complex* data) const;
+    void Execute(Vector& data) const { Execute(data.data()); }
+
+    // Forward transform, output in bit-reversed order
+    void ForwardBitReversed(Complex* data) const;
+    void ForwardBitReversed(Vector& data) const { ForwardBitReversed(data.data()); }
+    // Inverse including the 1/N, input in bit-reversed order:
+    // InverseBitReversed(ForwardBitReversed(x)) == x
+    void InverseBitReversed(Complex* data) const;
+    void InverseBitReversed(Vector& data) const { InverseBitReversed(data.data()); }
+
+    u_int Size() const { return size_; }
+    Radix GetRadix() const { return radix_; }
+
+private:
+    // the DIT stages for radix_, input already bit-reversed
+    void Stages(Complex* data) const;
+    u_int Leaves(Complex* data) const;
+    void Butterflies(Complex* data, u_int firstBlock, u_int lastBlock) const;
+    void Butterflies4(Complex* data) const;
+    void ButterfliesSplit(Complex* data, u_int n) const;
+
+    u_int size_;
+    Radix radix_;
+    u_int numBits_;
+    Vector twiddles_;
+    BitReversal permute_;
+};
+
+using FFTPlan = BasicFFTPlan<double>;
+using FFTPlanF = BasicFFTPlan<float>;
+
+#endif // PLAN_H
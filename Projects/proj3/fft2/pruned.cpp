@@ -0,0 +1,173 @@
+#include "pruned.h"
+#include "complex_math.h"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+    u_int PowerTwoAtLeast(u_int n)
+    {
+        u_int power = 1;
+        while(power < n) power <<= 1;
+        return power;
+    }
+}
+
+PrunedFFT::PrunedFFT(u_int _size, u_int _inputs, u_int _firstBin, u_int _bins)
+: size_(_size), inputs_(_inputs), firstBin_(_firstBin), bins_(_bins),
+  span_(PowerTwoAtLeast(_inputs)), numBits_(0)
+{
+    // the --pruned checks: with no inputs Execute would still read
+    // input[0], past N inputs or bins it would run off the buffers
+    assert(size_ > 0 && (size_ & (size_ - 1)) == 0);
+    assert(inputs_ >= 1 && inputs_ <= size_);
+    assert(bins_ >= 1 && bins_ <= size_);
+    firstBin_ %= size_;
+
+    // log2(N)
+    for(u_int n = size_; n > 1; n >>= 1) ++numBits_;
+
+    twiddles_.resize(size_);
+    for(u_int k = 0; k < size_; ++k)
+    {
+        double angle = -2.0 * M_PI * k / size_;
+        twiddles_[k] = complex(cos(angle), sin(angle));
+    }
+    buffers_[0].resize(size_);
+    buffers_[1].resize(size_);
+}
+
+void PrunedFFT::Radix2Stage(const complex* x, complex* y, u_int n) const
+{
+    u_int s = size_ / n;
+    u_int half = n / 2;
+    u_int pLimit = std::min(half, span_);
+    bool pairs = span_ > half;
+    u_int qLimit = std::min(s, bins_);
+    bool firstOnly = s >= bins_;
+    for(u_int p = 0; p < pLimit; ++p)
+    {
+        const complex& w = twiddles_[p * s];
+        const complex* xa = x + static_cast<size_t>(s) * p;
+        const complex* xb = xa + static_cast<size_t>(s) * half;
+        complex* y0 = y + static_cast<size_t>(s) * 2 * p;
+        complex* y1 = y0 + s;
+        for(u_int q = 0; q < qLimit; ++q)
+        {
+            complex a = xa[q];
+            complex b = pairs ? xb[q] : complex(0.0, 0.0);
+            y0[q] = a + b;
+            if(!firstOnly) y1[q] = Rotate(w, a.real() - b.real(), a.imag() - b.imag());
+        }
+    }
+}
+
+void PrunedFFT::Radix4Stage(const complex* x, complex* y, u_int n) const
+{
+    u_int s = size_ / n;
+    u_int quarter = n / 4;
+    size_t step = static_cast<size_t>(s) * quarter;
+    // nonzero inputs per butterfly: a; a, b; or all four
+    u_int pLimit = std::min(quarter, span_);
+    u_int inputs = span_ >= n ? 4 : (span_ > quarter ? 2 : 1);
+    u_int qLimit = std::min(s, bins_);
+    bool firstOnly = s >= bins_;
+    for(u_int p = 0; p < pLimit; ++p)
+    {
+        const complex& w1 = twiddles_[p * s];
+        const complex& w2 = twiddles_[2 * p * s];
+        const complex& w3 = twiddles_[3 * p * s];
+        const complex* xa = x + static_cast<size_t>(s) * p;
+        const complex* xb = xa + step;
+        const complex* xc = xb + step;
+        const complex* xd = xc + step;
+        complex* y0 = y + static_cast<size_t>(s) * 4 * p;
+        complex* y1 = y0 + s;
+        complex* y2 = y1 + s;
+        complex* y3 = y2 + s;
+        if(firstOnly)
+        {
+            for(u_int q = 0; q < qLimit; ++q)
+            {
+                complex sum = xa[q];
+                if(inputs > 1) sum += xb[q];
+                if(inputs > 2) sum += xc[q] + xd[q];
+                y0[q] = sum;
+            }
+            continue;
+        }
+        if(inputs == 1)
+        {
+            for(u_int q = 0; q < qLimit; ++q)
+            {
+                complex a = xa[q];
+                y0[q] = a;
+                y1[q] = Rotate(w1, a.real(), a.imag());
+                y2[q] = Rotate(w2, a.real(), a.imag());
+                y3[q] = Rotate(w3, a.real(), a.imag());
+            }
+            continue;
+        }
+        if(inputs == 2)
+        {
+            for(u_int q = 0; q < qLimit; ++q)
+            {
+                complex a = xa[q], b = xb[q];
+                y0[q] = a + b;
+                // a - i b, a - b, a + i b
+                y1[q] = Rotate(w1, a.real() + b.imag(), a.imag() - b.real());
+                y2[q] = Rotate(w2, a.real() - b.real(), a.imag() - b.imag());
+                y3[q] = Rotate(w3, a.real() - b.imag(), a.imag() + b.real());
+            }
+            continue;
+        }
+        for(u_int q = 0; q < qLimit; ++q)
+        {
+            complex a = xa[q], b = xb[q], c = xc[q], d = xd[q];
+            double apcR = a.real() + c.real(), apcI = a.imag() + c.imag();
+            double amcR = a.real() - c.real(), amcI = a.imag() - c.imag();
+            double bpdR = b.real() + d.real(), bpdI = b.imag() + d.imag();
+            double bmdR = b.real() - d.real(), bmdI = b.imag() - d.imag();
+            y0[q] = complex(apcR + bpdR, apcI + bpdI);
+            // -i (b - d) = (bmdI, -bmdR)
+            y1[q] = Rotate(w1, amcR + bmdI, amcI - bmdR);
+            y2[q] = Rotate(w2, apcR - bpdR, apcI - bpdI);
+            y3[q] = Rotate(w3, amcR - bmdI, amcI + bmdR);
+        }
+    }
+}
+
+void PrunedFFT::Execute(const complex* input, complex* output)
+{
+    // the stages read Lp values: copy when L < Lp or the band needs
+    // x[n] W_N^(n firstBin), exponent mod N through the mask
+    const complex* x = input;
+    if(firstBin_ != 0 || inputs_ != span_)
+    {
+        const size_t mask = size_ - 1;
+        complex* staged = buffers_[1].data();
+        for(u_int n = 0; n < inputs_; ++n)
+        {
+            staged[n] = input[n] * twiddles_[(static_cast<size_t>(n) * firstBin_) & mask];
+        }
+        std::fill(staged + inputs_, staged + span_, complex(0.0, 0.0));
+        x = staged;
+    }
+
+    u_int n = size_;
+    u_int stage = 0;
+    if(numBits_ % 2)
+    {
+        Radix2Stage(x, buffers_[0].data(), n);
+        x = buffers_[0].data();
+        n /= 2;
+        ++stage;
+    }
+    for(; n >= 4; n /= 4, ++stage)
+    {
+        complex* y = buffers_[stage % 2].data();
+        Radix4Stage(x, y, n);
+        x = y;
+    }
+    std::copy(x, x + bins_, output);
+}
@@ -0,0 +1,65 @@
+#ifndef PRUNED_H
+#define PRUNED_H
+
+#include "plan.h"
+
+/*
+    Pruned FFT: only the nonzero inputs, only the wanted bins.
+    A frame of L samples zero padded to N, or a band of K bins out
+    of N, leaves butterflies of the full transform working on zeros
+    or producing values nobody reads. This runs the Stockham stages
+    of stockham.h (n the sub-transform length, s = N/n of them
+    interleaved, inputs x[q + s p], outputs y[q + s (4p + i)]) and
+    leaves those butterflies out:
+
+    inputs  with Lp = L rounded up to a power of two, a stage only
+            ever reads nonzero values at p < Lp, and writes exactly
+            the values the next stage reads at p < Lp. So:
+                Lp <= n/4   b = c = d = 0: y_i = W_n^(ip) a, p < Lp
+                Lp == n/2   c = d = 0, two-input butterflies
+                Lp >= n     full stage
+            The early stages shrink to L, 4L, 16L, ... values.
+    bins    output k depends on sub-transform q of a stage only if
+            q + s i < K, so a stage runs q < min(s, K), and once
+            s >= K only y0 = a + b + c + d of each butterfly.
+            The late stages shrink to K values and a quarter of the
+            multiplies.
+    A band K bins wide at firstBin goes through the same stages:
+    x[n] W_N^(n firstBin) has bin firstBin + k of x at bin k.
+    Like StockhamFFT, a plan holds its ping-pong buffers, so
+    Execute is not const: one plan per thread.
+*/
+class PrunedFFT
+{
+public:
+    // N a power of two; only the first _inputs values (1..N) may be
+    // nonzero; _bins bins (1..N) wanted, from _firstBin, wrapping mod N.
+    // Asserted, as --pruned checks them before building a plan.
+    PrunedFFT(u_int _size, u_int _inputs, u_int _firstBin, u_int _bins);
+
+    // output[k] = X[(firstBin + k) mod N], k < Bins(), X the DFT of
+    // input[0 .. Inputs()) followed by zeros; output != input
+    void Execute(const complex* input, complex* output);
+
+    u_int Size() const { return size_; }
+    u_int Inputs() const { return inputs_; }
+    u_int FirstBin() const { return firstBin_; }
+    u_int Bins() const { return bins_; }
+
+private:
+    // one pruned stage from x to y for sub-transforms of length n
+    void Radix2Stage(const complex* x, complex* y, u_int n) const;
+    void Radix4Stage(const complex* x, complex* y, u_int n) const;
+
+    u_int size_;
+    u_int inputs_;
+    u_int firstBin_;
+    u_int bins_;
+    u_int span_;  // Lp
+    u_int numBits_;
+    c_vector twiddles_;
+    // stage i writes buffers_[i % 2]; a staged input goes in buffers_[1]
+    c_vector buffers_[2];
+};
+
+#endif // PRUNED_H
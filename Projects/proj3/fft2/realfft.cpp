@@ -0,0 +1,94 @@
+#include "realfft.h"
+
+RealFFT::RealFFT(u_int _size)
+: size_(_size), half_(_size / 2), packed_(_size / 2)
+{
+    twiddles_.resize(size_ / 2);
+    for(u_int k = 0; k < size_ / 2; ++k)
+    {
+        double angle = -2.0 * M_PI * k / size_;
+        twiddles_[k] = complex(cos(angle), sin(angle));
+    }
+}
+
+// Samples are widened to double as they are packed
+template<typename Sample>
+void RealFFT::PackedForward(const Sample* input, complex* output) const
+{
+    u_int M = size_ / 2;
+    for(u_int n = 0; n < M; ++n)
+    {
+        output[n] = complex(input[2 * n], input[2 * n + 1]);
+    }
+    half_.Execute(output);
+    Untangle(output);
+}
+
+void RealFFT::Forward(const double* input, complex* output) const
+{
+    PackedForward(input, output);
+}
+
+void RealFFT::Forward(const short* input, complex* output) const
+{
+    PackedForward(input, output);
+}
+
+// data holds Z[0..M-1] on entry, X[0..M] on exit.
+// Bins k and M-k need the same two Z values, so each pair is
+// read first and then both written in place.
+void RealFFT::Untangle(complex* data) const
+{
+    u_int M = size_ / 2;
+    complex z0 = data[0];
+    // E[0] = Re Z[0], O[0] = Im Z[0], W^0 = 1, W^M = -1
+    data[0] = complex(z0.real() + z0.imag(), 0.0);
+    data[M] = complex(z0.real() - z0.imag(), 0.0);
+
+    for(u_int k = 1; k <= M / 2; ++k)
+    {
+        u_int mirror = M - k;
+        complex zk = data[k];
+        complex zm = data[mirror];
+
+        complex even = 0.5 * (zk + std::conj(zm));
+        // (Z[k] - conj(Z[M-k])) / 2i
+        complex diff = 0.5 * (zk - std::conj(zm));
+        complex odd(diff.imag(), -diff.real());
+        data[k] = even + twiddles_[k] * odd;
+
+        if(mirror != k)
+        {
+            // E[M-k] = conj(E[k]), O[M-k] = conj(O[k])
+            // W_N^(M-k) = -conj(W_N^k)
+            data[mirror] = std::conj(even) - std::conj(twiddles_[k]) * std::conj(odd);
+        }
+    }
+}
+
+void RealFFT::Inverse(const complex* input, double* output)
+{
+    u_int M = size_ / 2;
+    complex* packed = packed_.data();
+
+    for(u_int k = 0; k < M; ++k)
+    {
+        complex xk = input[k];
+        complex xm = std::conj(input[M - k]);
+        complex even = 0.5 * (xk + xm);
+        complex odd = 0.5 * (xk - xm) * std::conj(twiddles_[k]);
+        // Z[k] = E[k] + i O[k]
+        packed[k] = even + complex(-odd.imag(), odd.real());
+    }
+
+    // inverse through the forward plan: conj(FFT(conj(Z))) / M
+    for(u_int k = 0; k < M; ++k) packed[k] = std::conj(packed[k]);
+    half_.Execute(packed);
+    // z[n] = x[2n] + i x[2n+1], conjugated and scaled on the way out
+    double scale = 1.0 / M;
+    for(u_int n = 0; n < M; ++n)
+    {
+        output[2 * n] = packed[n].real() * scale;
+        output[2 * n + 1] = -packed[n].imag() * scale;
+    }
+}
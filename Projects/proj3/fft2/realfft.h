@@ -0,0 +1,51 @@
+#ifndef REALFFT_H
+#define REALFFT_H
+
+#include "plan.h"
+
+/*
+    Real-input FFT through the half-length complex packing trick.
+    A real signal of N samples is packed into N/2 complex values,
+        z[n] = x[2n] + i x[2n+1]
+    transformed by an N/2-point FFTPlan, and untangled with
+        E[k] = (Z[k] + conj(Z[M-k])) / 2          (DFT of x[2n])
+        O[k] = (Z[k] - conj(Z[M-k])) / 2i         (DFT of x[2n+1])
+        X[k] = E[k] + W_N^k O[k]                  (k = 0 to M, M = N/2)
+    Only bins 0..N/2 are returned; the rest are conj(X[N-k]).
+    Forward works in the caller's output buffer; Inverse packs Z
+    into an N/2-value buffer of the plan's own and unpacks it into
+    the caller's samples, so it is not const: one plan per thread.
+    No allocation either way.
+*/
+class RealFFT
+{
+public:
+    // N must be a power of two, at least 2
+    RealFFT(u_int _size);
+
+    // N real samples -> N/2+1 bins
+    void Forward(const double* input, complex* output) const;
+    // 16-bit PCM (WAV) samples, widened while packing
+    void Forward(const short* input, complex* output) const;
+    // N/2+1 bins -> N real samples, scaled by 1/N so that
+    // Inverse(Forward(x)) == x
+    void Inverse(const complex* input, double* output);
+
+    u_int Size() const { return size_; }
+    u_int Bins() const { return size_ / 2 + 1; }
+
+private:
+    // pack, N/2-point FFT, untangle: both Forward overloads
+    template<typename Sample>
+    void PackedForward(const Sample* input, complex* output) const;
+    void Untangle(complex* data) const;
+
+    u_int size_;
+    FFTPlan half_;
+    // W_N^k for k < N/2
+    c_vector twiddles_;
+    // Z for Inverse, N/2 values
+    c_vector packed_;
+};
+
+#endif // REALFFT_H
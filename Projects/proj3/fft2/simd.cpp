@@ -0,0 +1,203 @@
+#include "simd.h"
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FFT2_X86 1
+#endif
+
+namespace
+{
+    // Stages with half-size from startHalf up to N/2
+    void StagesScalar(double* re, double* im, u_int size,
+        const double* twRe, const double* twIm, u_int startHalf)
+    {
+        for(u_int half = startHalf; half < size; half <<= 1)
+        {
+            const double* wRe = twRe + (half - 1);
+            const double* wIm = twIm + (half - 1);
+            for(u_int block = 0; block < size; block += 2 * half)
+            {
+                double* eRe = re + block;
+                double* eIm = im + block;
+                double* oRe = eRe + half;
+                double* oIm = eIm + half;
+                for(u_int i = 0; i < half; ++i)
+                {
+                    double tr = wRe[i] * oRe[i] - wIm[i] * oIm[i];
+                    double ti = wRe[i] * oIm[i] + wIm[i] * oRe[i];
+                    oRe[i] = eRe[i] - tr;
+                    oIm[i] = eIm[i] - ti;
+                    eRe[i] += tr;
+                    eIm[i] += ti;
+                }
+            }
+        }
+    }
+
+#ifdef FFT2_X86
+    __attribute__((target("avx2,fma")))
+    void StagesAVX2(double* re, double* im, u_int size,
+        const double* twRe, const double* twIm)
+    {
+        // half = 1, 2 are narrower than a register: finish each
+        // 4-point block scalar, then vectorize from half = 4 on
+        u_int leaf = size < 4 ? size : 4;
+        for(u_int block = 0; block < size; block += leaf)
+        {
+            StagesScalar(re + block, im + block, leaf, twRe, twIm, 1);
+        }
+        for(u_int half = 4; half < size; half <<= 1)
+        {
+            const double* wRe = twRe + (half - 1);
+            const double* wIm = twIm + (half - 1);
+            for(u_int block = 0; block < size; block += 2 * half)
+            {
+                double* eRe = re + block;
+                double* eIm = im + block;
+                double* oRe = eRe + half;
+                double* oIm = eIm + half;
+                for(u_int i = 0; i < half; i += 4)
+                {
+                    __m256d wr = _mm256_loadu_pd(wRe + i);
+                    __m256d wi = _mm256_loadu_pd(wIm + i);
+                    __m256d orr = _mm256_loadu_pd(oRe + i);
+                    __m256d oi = _mm256_loadu_pd(oIm + i);
+                    __m256d er = _mm256_loadu_pd(eRe + i);
+                    __m256d ei = _mm256_loadu_pd(eIm + i);
+                    __m256d tr = _mm256_fmsub_pd(wr, orr, _mm256_mul_pd(wi, oi));
+                    __m256d ti = _mm256_fmadd_pd(wr, oi, _mm256_mul_pd(wi, orr));
+                    _mm256_storeu_pd(oRe + i, _mm256_sub_pd(er, tr));
+                    _mm256_storeu_pd(oIm + i, _mm256_sub_pd(ei, ti));
+                    _mm256_storeu_pd(eRe + i, _mm256_add_pd(er, tr));
+                    _mm256_storeu_pd(eIm + i, _mm256_add_pd(ei, ti));
+                }
+            }
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    void StagesAVX512(double* re, double* im, u_int size,
+        const double* twRe, const double* twIm)
+    {
+        // half = 1, 2, 4 are narrower than a register
+        u_int leaf = size < 8 ? size : 8;
+        for(u_int block = 0; block < size; block += leaf)
+        {
+            StagesScalar(re + block, im + block, leaf, twRe, twIm, 1);
+        }
+        for(u_int half = 8; half < size; half <<= 1)
+        {
+            const double* wRe = twRe + (half - 1);
+            const double* wIm = twIm + (half - 1);
+            for(u_int block = 0; block < size; block += 2 * half)
+            {
+                double* eRe = re + block;
+                double* eIm = im + block;
+                double* oRe = eRe + half;
+                double* oIm = eIm + half;
+                for(u_int i = 0; i < half; i += 8)
+                {
+                    __m512d wr = _mm512_loadu_pd(wRe + i);
+                    __m512d wi = _mm512_loadu_pd(wIm + i);
+                    __m512d orr = _mm512_loadu_pd(oRe + i);
+                    __m512d oi = _mm512_loadu_pd(oIm + i);
+                    __m512d er = _mm512_loadu_pd(eRe + i);
+                    __m512d ei = _mm512_loadu_pd(eIm + i);
+                    __m512d tr = _mm512_fmsub_pd(wr, orr, _mm512_mul_pd(wi, oi));
+                    __m512d ti = _mm512_fmadd_pd(wr, oi, _mm512_mul_pd(wi, orr));
+                    _mm512_storeu_pd(oRe + i, _mm512_sub_pd(er, tr));
+                    _mm512_storeu_pd(oIm + i, _mm512_sub_pd(ei, ti));
+                    _mm512_storeu_pd(eRe + i, _mm512_add_pd(er, tr));
+                    _mm512_storeu_pd(eIm + i, _mm512_add_pd(ei, ti));
+                }
+            }
+        }
+    }
+#endif
+}
+
+const char* KernelName(Kernel kernel)
+{
+    switch(kernel)
+    {
+        case AVX2Kernel: return "AVX2";
+        case AVX512Kernel: return "AVX-512";
+        default: return "scalar";
+    }
+}
+
+bool KernelSupported(Kernel kernel)
+{
+#ifdef FFT2_X86
+    switch(kernel)
+    {
+        case AVX2Kernel:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case AVX512Kernel:
+            return __builtin_cpu_supports("avx512f");
+        default:
+            return true;
+    }
+#else
+    return kernel == ScalarKernel;
+#endif
+}
+
+Kernel BestKernel()
+{
+    if(KernelSupported(AVX512Kernel)) return AVX512Kernel;
+    if(KernelSupported(AVX2Kernel)) return AVX2Kernel;
+    return ScalarKernel;
+}
+
+SimdPlan::SimdPlan(u_int _size, Kernel _kernel)
+: size_(_size), kernel_(_kernel), permute_(_size)
+{
+    if(!KernelSupported(kernel_)) kernel_ = BestKernel();
+
+    // stage tables: W_2h^i for i < h, stage h at offset h-1
+    twiddleRe_.resize(size_ > 1 ? size_ - 1 : 0);
+    twiddleIm_.resize(twiddleRe_.size());
+    for(u_int half = 1; half < size_; half <<= 1)
+    {
+        for(u_int i = 0; i < half; ++i)
+        {
+            double angle = -M_PI * i / half;
+            twiddleRe_[half - 1 + i] = cos(angle);
+            twiddleIm_[half - 1 + i] = sin(angle);
+        }
+    }
+    re_.resize(size_);
+    im_.resize(size_);
+}
+
+void SimdPlan::Execute(double* re, double* im) const
+{
+    permute_.Execute(re);
+    permute_.Execute(im);
+    const double* twRe = twiddleRe_.data();
+    const double* twIm = twiddleIm_.data();
+    switch(kernel_)
+    {
+#ifdef FFT2_X86
+        case AVX2Kernel: StagesAVX2(re, im, size_, twRe, twIm); break;
+        case AVX512Kernel: StagesAVX512(re, im, size_, twRe, twIm); break;
+#endif
+        default: StagesScalar(re, im, size_, twRe, twIm, 1); break;
+    }
+}
+
+void SimdPlan::Execute(complex* data)
+{
+    for(u_int i = 0; i < size_; ++i)
+    {
+        re_[i] = data[i].real();
+        im_[i] = data[i].imag();
+    }
+    Execute(re_.data(), im_.data());
+    for(u_int i = 0; i < size_; ++i)
+    {
+        data[i] = complex(re_[i], im_[i]);
+    }
+}
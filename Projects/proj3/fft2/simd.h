@@ -0,0 +1,59 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "../bitrev/permute.h"
+
+// Instruction set used for the butterflies of a SimdPlan
+enum Kernel
+{
+    ScalarKernel,   // one butterfly at a time
+    AVX2Kernel,     // 4 butterflies per instruction (4 doubles per register)
+    AVX512Kernel    // 8 butterflies per instruction
+};
+
+const char* KernelName(Kernel kernel);
+// Checked against the running CPU, not the compile flags
+bool KernelSupported(Kernel kernel);
+Kernel BestKernel();
+
+/*
+    Radix-2 FFT over a split real/imag layout.
+    std::complex<double> interleaves re,im so a vector register
+    holds half a butterfly, and every complex multiply goes through
+    the NaN-checking libcall unless built with fast-math. With the
+    real and imaginary parts in separate arrays each lane is one
+    butterfly:
+        tr = wr*or - wi*oi        ti = wr*oi + wi*or
+        re[odd] = er - tr         re[even] = er + tr
+    Twiddles are stored per stage, contiguous in i, so they load
+    as whole vectors too: the stage with half-size h starts at h-1.
+    Stages with h smaller than the vector width run scalar.
+*/
+class SimdPlan
+{
+public:
+    // Falls back to BestKernel() if _kernel is not supported here
+    SimdPlan(u_int _size, Kernel _kernel = BestKernel());
+
+    // In place on split arrays of size_ values each
+    void Execute(double* re, double* im) const;
+    // In place on interleaved data, through the plan's split
+    // buffers: not const, one plan per thread
+    void Execute(complex* data);
+    void Execute(c_vector& data) { Execute(data.data()); }
+
+    u_int Size() const { return size_; }
+    Kernel GetKernel() const { return kernel_; }
+
+private:
+    u_int size_;
+    Kernel kernel_;
+    BitReversal permute_;
+    std::vector<double> twiddleRe_;
+    std::vector<double> twiddleIm_;
+    // scratch for the interleaved Execute
+    std::vector<double> re_;
+    std::vector<double> im_;
+};
+
+#endif // SIMD_H
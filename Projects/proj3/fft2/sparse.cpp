@@ -0,0 +1,186 @@
+#include "sparse.h"
+#include "engine.h"
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+
+namespace
+{
+    // B = 4k keeps most of k bins alone in a bucket each round
+    const u_int bucketsPerBin = 4;
+    // the search gives up rather than read more than N / 4 samples
+    const u_int sparseBudget = 4;
+    // τ2 must predict a singleton bucket this closely
+    // (relative energy of the difference)
+    const double singletonTolerance = 1e-4;
+
+    u_int BucketCount(u_int N, u_int k)
+    {
+        if(k >= N / bucketsPerBin) return N;
+        u_int buckets = 1;
+        while(buckets < bucketsPerBin * k) buckets <<= 1;
+        return buckets;
+    }
+
+    // e^(2πi exponent / N)
+    complex Phase(uint64_t exponent, u_int N)
+    {
+        return std::polar(1.0, 2.0 * M_PI * static_cast<double>(exponent & (N - 1)) / N);
+    }
+
+    bool ByBin(const SparseBin& a, const SparseBin& b) { return a.bin < b.bin; }
+}
+
+SparseFFT::SparseFFT(u_int _size, u_int _k, double _tolerance)
+: size_(_size), k_(_k), tolerance_(_tolerance), buckets_(BucketCount(_size, _k)),
+  residual_(0.0), samples_(0), rounds_(0), dense_(false)
+{}
+
+bool SparseFFT::Execute(const complex* data)
+{
+    bins_.clear();
+    residual_ = 0.0;
+    samples_ = 0;
+    rounds_ = 0;
+    dense_ = false;
+    if(Search(data)) return true;
+    DenseFFT(data);
+    return residual_ <= tolerance_;
+}
+
+bool SparseFFT::Search(const complex* data)
+{
+    // not even Y_0 and Y_τ2 within the budget
+    if(2 * static_cast<size_t>(buckets_.Size()) > size_ / sparseBudget) return false;
+    const uint64_t mask = size_ - 1;
+    u_int numBits = 0;
+    for(u_int n = size_; n > 1; n >>= 1) ++numBits;
+    // same τ2 on every run, so the same samples and bins
+    std::mt19937 random(320);
+    std::uniform_int_distribution<u_int> shift(2, size_ - 1);
+    const double match = std::max(singletonTolerance, tolerance_);
+
+    std::unique_ptr<StockhamFFT> wider;
+    StockhamFFT* plan = &buckets_;
+    std::map<u_int, complex> found;
+    c_vector y;
+    std::vector<uint64_t> tau;
+    double energy = 0.0, left = 0.0;
+    bool empty = false;
+    while(!empty)
+    {
+        const u_int B = plan->Size();
+        u_int bucketBits = 0;
+        for(u_int n = B; n > 1; n >>= 1) ++bucketBits;
+        // τ = 0, a random τ2, then N / 2^(j+1) for bits j of f above b
+        tau.assign(1, 0);
+        tau.push_back(shift(random));
+        for(u_int j = bucketBits; j < numBits; ++j) tau.push_back(size_ >> (j + 1));
+        if(samples_ + tau.size() * B > size_ / sparseBudget) return false;
+        ++rounds_;
+
+        const uint64_t D = size_ / B;
+        const double scale = static_cast<double>(B) / size_;
+        y.resize(tau.size() * B);
+        for(size_t t = 0; t < tau.size(); ++t)
+        {
+            complex* yt = y.data() + t * B;
+            for(u_int j = 0; j < B; ++j) yt[j] = data[(j * D + tau[t]) & mask];
+            plan->Execute(yt);
+        }
+        samples_ += tau.size() * B;
+
+        // take out the bins found so far; what is left, over every
+        // shift, is what they do not explain
+        energy = 0.0;
+        for(const complex& value : y) energy += std::norm(value);
+        for(const auto& bin : found)
+        {
+            for(size_t t = 0; t < tau.size(); ++t)
+            {
+                y[t * B + (bin.first & (B - 1))] -= scale * bin.second * Phase(bin.first * tau[t], size_);
+            }
+        }
+        left = 0.0;
+        for(const complex& value : y) left += std::norm(value);
+        empty = left <= tolerance_ * energy;
+        if(empty) break;
+
+        double floor = tolerance_ * energy / y.size();
+        for(u_int b = 0; b < B; ++b)
+        {
+            complex y0 = y[b];
+            if(std::norm(y0) <= floor) continue;
+            // one bit of f per shift: with f mod 2^j known,
+            // Y_τ / Y_0 = e^(2πi (f mod 2^(j+1)) / 2^(j+1)) is
+            // e^(2πi (f mod 2^j) / 2^(j+1)) times +1 or -1
+            uint64_t f = b;
+            for(u_int j = bucketBits; j < numBits; ++j)
+            {
+                complex ratio = y[(2 + j - bucketBits) * B + b] / y0;
+                double known = -2.0 * M_PI * static_cast<double>(f) / static_cast<double>(uint64_t(2) << j);
+                if((ratio * std::polar(1.0, known)).real() < 0.0) f |= uint64_t(1) << j;
+            }
+            // a collision decodes to some f; τ2 has to agree with it
+            complex predicted = y0 * Phase(f * tau[1], size_);
+            if(std::norm(y[B + b] - predicted) > match * std::norm(y0)) continue;
+            found[static_cast<u_int>(f)] += y0 / scale;
+        }
+        // what is left shares buckets f mod B, whatever the shifts;
+        // only more buckets split it
+        if(2 * B > size_) break;
+        wider.reset(new StockhamFFT(2 * B));
+        plan = wider.get();
+    }
+    if(!empty) return false;
+
+    // the k largest; anything past them counts against k-sparsity
+    for(const auto& bin : found) bins_.push_back({bin.first, bin.second});
+    std::sort(bins_.begin(), bins_.end(), [](const SparseBin& a, const SparseBin& b)
+    {
+        return std::norm(a.value) > std::norm(b.value);
+    });
+    double total = 0.0, dropped = 0.0;
+    for(const SparseBin& bin : bins_) total += std::norm(bin.value);
+    while(!bins_.empty() && (bins_.size() > k_ || std::norm(bins_.back().value) <= tolerance_ * total))
+    {
+        dropped += std::norm(bins_.back().value);
+        bins_.pop_back();
+    }
+    std::sort(bins_.begin(), bins_.end(), ByBin);
+    residual_ = (energy > 0.0 ? left / energy : 0.0) + (total > 0.0 ? dropped / total : 0.0);
+    return residual_ <= tolerance_;
+}
+
+void SparseFFT::DenseFFT(const complex* data)
+{
+    dense_ = true;
+    samples_ += size_;
+    c_vector spectrum(data, data + size_);
+    FFTEngine(size_).Execute(spectrum);
+
+    std::vector<u_int> order(size_);
+    std::iota(order.begin(), order.end(), 0u);
+    u_int k = std::min(k_, size_);
+    std::partial_sort(order.begin(), order.begin() + k, order.end(), [&spectrum](u_int a, u_int b)
+    {
+        return std::norm(spectrum[a]) > std::norm(spectrum[b]);
+    });
+
+    double total = 0.0, kept = 0.0;
+    for(const complex& value : spectrum) total += std::norm(value);
+    bins_.clear();
+    for(u_int i = 0; i < k; ++i)
+    {
+        // as after a search, no bins that are next to nothing
+        double binEnergy = std::norm(spectrum[order[i]]);
+        if(binEnergy <= tolerance_ * total) break;
+        kept += binEnergy;
+        bins_.push_back({order[i], spectrum[order[i]]});
+    }
+    std::sort(bins_.begin(), bins_.end(), ByBin);
+    residual_ = total > 0.0 ? (total - kept) / total : 0.0;
+}
@@ -0,0 +1,87 @@
+#ifndef SPARSE_H
+#define SPARSE_H
+
+#include <vector>
+#include "stockham.h"
+
+// Energy outside the k bins, relative to the total, still counted
+// as k-sparse (the text inputs carry about 1e-20 of rounding)
+const double sparseTolerance = 1e-6;
+
+struct SparseBin
+{
+    u_int bin;
+    complex value;
+};
+
+/*
+    Top-k FFT for signals whose spectrum has only k significant bins
+    (cosines, Buzz harmonics), reading far fewer than N samples.
+    B samples at stride D = N/B, shifted by τ, alias the spectrum
+    into B buckets, bin f into bucket f mod B:
+        y[j] = x[j D + τ]                  j < B
+        Y_τ[b] = (B/N) Σ X[f] e^(2πi f τ / N)    over f ≡ b (mod B)
+    one B-point FFT each, B = 4k to start. A bucket holding one bin
+    gives X[f] = (N/B) Y_0[b], and f bit by bit above b: with
+    τ = N / 2^(j+1), Y_τ / Y_0 is e^(2πi (f mod 2^(j+1)) / 2^(j+1)),
+    which tells bit j once the bits below it are known, with a
+    quarter turn of margin for noise. A random τ2 must agree before
+    f is taken; a bucket holding several bins decodes to something
+    τ2 does not confirm.
+    Bins found so far are subtracted from every bucket, so each
+    round only works on what is left. Bins in one bucket stay
+    together under any shift or odd multiplier of f (N is a power
+    of two), so the next round doubles B instead. The search stops
+    once the buckets hold less than the tolerance of their energy:
+    about B log2(N/B) samples per round, independent of N.
+
+    A signal with more than k significant bins never gets there, nor
+    does a comb of bins spaced a large power of two apart. Once the
+    next round would take the search past N/4 samples it runs a
+    dense FFT (FFTEngine, the kernel FFT2::Execute picks) and keeps
+    the k largest bins; Residual() then is the exact energy outside
+    them.
+*/
+class SparseFFT
+{
+public:
+    // N a power of two, 1 <= k <= N
+    SparseFFT(u_int _size, u_int _k, double _tolerance = sparseTolerance);
+
+    // Reads N values at data (only Samples() of them when sparse);
+    // false if the signal is not k-sparse within the tolerance,
+    // in which case Bins() are the dense FFT's k largest
+    bool Execute(const complex* data);
+
+    // at most k bins, ascending
+    const std::vector<SparseBin>& Bins() const { return bins_; }
+    // relative energy outside Bins(): estimated from the buckets
+    // after a sparse search, exact after a dense FFT
+    double Residual() const { return residual_; }
+    size_t Samples() const { return samples_; }
+    u_int Rounds() const { return rounds_; }
+    // true if Bins() came from the dense FFT
+    bool Dense() const { return dense_; }
+
+    u_int Size() const { return size_; }
+    u_int K() const { return k_; }
+    // B of the first round
+    u_int Buckets() const { return buckets_.Size(); }
+
+private:
+    // false if the budget ran out before the buckets were empty
+    bool Search(const complex* data);
+    void DenseFFT(const complex* data);
+
+    u_int size_;
+    u_int k_;
+    double tolerance_;
+    StockhamFFT buckets_;  // B points; wider rounds build their own
+    std::vector<SparseBin> bins_;
+    double residual_;
+    size_t samples_;
+    u_int rounds_;
+    bool dense_;
+};
+
+#endif // SPARSE_H
@@ -0,0 +1,110 @@
+#include "stockham.h"
+#include "complex_math.h"
+#include <algorithm>
+
+StockhamFFT::StockhamFFT(u_int _size)
+: size_(_size), numBits_(0), work_(_size)
+{
+    // log2(N)
+    for(u_int n = size_; n > 1; n >>= 1) ++numBits_;
+
+    twiddles_.resize(size_);
+    for(u_int k = 0; k < size_; ++k)
+    {
+        double angle = -2.0 * M_PI * k / size_;
+        twiddles_[k] = complex(cos(angle), sin(angle));
+    }
+}
+
+void StockhamFFT::Radix2Stage(const complex* x, complex* y, u_int n) const
+{
+    // y[q + s 2p] = a + b,  y[q + s (2p + 1)] = W_n^p (a - b)
+    u_int s = size_ / n;
+    u_int half = n / 2;
+    for(u_int p = 0; p < half; ++p)
+    {
+        const complex& w = twiddles_[p * s];
+        const complex* xa = x + static_cast<size_t>(s) * p;
+        const complex* xb = xa + static_cast<size_t>(s) * half;
+        complex* y0 = y + static_cast<size_t>(s) * 2 * p;
+        complex* y1 = y0 + s;
+        for(u_int q = 0; q < s; ++q)
+        {
+            complex a = xa[q], b = xb[q];
+            y0[q] = a + b;
+            y1[q] = Rotate(w, a.real() - b.real(), a.imag() - b.imag());
+        }
+    }
+}
+
+void StockhamFFT::Radix4Stage(const complex* x, complex* y, u_int n) const
+{
+    u_int s = size_ / n;
+    u_int quarter = n / 4;
+    size_t step = static_cast<size_t>(s) * quarter;
+    for(u_int p = 0; p < quarter; ++p)
+    {
+        const complex& w1 = twiddles_[p * s];
+        const complex& w2 = twiddles_[2 * p * s];
+        const complex& w3 = twiddles_[3 * p * s];
+        const complex* xa = x + static_cast<size_t>(s) * p;
+        const complex* xb = xa + step;
+        const complex* xc = xb + step;
+        const complex* xd = xc + step;
+        complex* y0 = y + static_cast<size_t>(s) * 4 * p;
+        complex* y1 = y0 + s;
+        complex* y2 = y1 + s;
+        complex* y3 = y2 + s;
+        for(u_int q = 0; q < s; ++q)
+        {
+            complex a = xa[q], b = xb[q], c = xc[q], d = xd[q];
+            double apcR = a.real() + c.real(), apcI = a.imag() + c.imag();
+            double amcR = a.real() - c.real(), amcI = a.imag() - c.imag();
+            double bpdR = b.real() + d.real(), bpdI = b.imag() + d.imag();
+            double bmdR = b.real() - d.real(), bmdI = b.imag() - d.imag();
+            y0[q] = complex(apcR + bpdR, apcI + bpdI);
+            // -i (b - d) = (bmdI, -bmdR)
+            y1[q] = Rotate(w1, amcR + bmdI, amcI - bmdR);
+            y2[q] = Rotate(w2, apcR - bpdR, apcI - bpdI);
+            y3[q] = Rotate(w3, amcR - bmdI, amcI + bmdR);
+        }
+    }
+}
+
+void StockhamFFT::Run(const complex* source, complex* const buffers[2]) const
+{
+    const complex* x = source;
+    u_int n = size_;
+    u_int stage = 0;
+    if(numBits_ % 2)
+    {
+        Radix2Stage(x, buffers[0], n);
+        x = buffers[0];
+        n /= 2;
+        ++stage;
+    }
+    for(; n >= 4; n /= 4, ++stage)
+    {
+        complex* y = buffers[stage % 2];
+        Radix4Stage(x, y, n);
+        x = y;
+    }
+}
+
+void StockhamFFT::Execute(complex* data)
+{
+    // even stage count: data -> work -> ... -> data
+    complex* const buffers[2] = {work_.data(), data};
+    Run(data, buffers);
+    if(Stages() % 2) std::copy(work_.begin(), work_.end(), data);
+}
+
+void StockhamFFT::Execute(const complex* input, complex* output)
+{
+    // the last stage, index Stages() - 1, writes output
+    complex* work = work_.data();
+    complex* const odd[2] = {output, work};
+    complex* const even[2] = {work, output};
+    if(Stages() == 0) std::copy(input, input + size_, output);
+    else Run(input, Stages() % 2 ? odd : even);
+}
@@ -0,0 +1,62 @@
+#ifndef STOCKHAM_H
+#define STOCKHAM_H
+
+#include "plan.h"
+
+/*
+    Stockham autosort FFT.
+    Each stage reads one buffer and writes the other, and the
+    write puts every value where the next stage wants it, so the
+    output comes out in natural order with no bit-reversal pass.
+    With n the current sub-transform length and s = N/n the number
+    of interleaved sub-transforms (n = N, s = 1 at the start),
+    a radix-4 stage over p < n/4, q < s is
+        a = x[q + s p]   b = x[q + s (p + n/4)]
+        c = x[q + s (p + n/2)]   d = x[q + s (p + 3n/4)]
+        y[q + s (4p)]     = (a + c) + (b + d)
+        y[q + s (4p + 1)] = W_n^p  ((a - c) - i (b - d))
+        y[q + s (4p + 2)] = W_n^2p ((a + c) - (b + d))
+        y[q + s (4p + 3)] = W_n^3p ((a - c) + i (b - d))
+    then n /= 4, s *= 4. The inner loop runs over q, so every read
+    and write is a run of s consecutive values: no power-of-two
+    stride walks the array as in the late in-place stages.
+    W_n^p = W_N^(p s) comes from one N-entry table. An odd log2(N)
+    starts with one radix-2 stage of the same form.
+
+    The in-place Execute ping-pongs between data and the plan's
+    work buffer and finishes in data; an odd number of stages needs
+    one extra copy at the end. The out-of-place Execute picks the
+    buffer order so the last stage lands in output and never does.
+*/
+class StockhamFFT
+{
+public:
+    // N a power of two
+    StockhamFFT(u_int _size);
+
+    // Both go through the plan's work buffer, so neither is const
+    // (one plan per thread). In place:
+    void Execute(complex* data);
+    void Execute(c_vector& data) { Execute(data.data()); }
+    // output = DFT(input); input is only read, output != input
+    void Execute(const complex* input, complex* output);
+
+    u_int Size() const { return size_; }
+    // radix-2 and radix-4 stages in all
+    u_int Stages() const { return (numBits_ + 1) / 2; }
+
+private:
+    // one stage from x to y for sub-transforms of length n
+    void Radix2Stage(const complex* x, complex* y, u_int n) const;
+    void Radix4Stage(const complex* x, complex* y, u_int n) const;
+    // every stage, first reading source; buffers[i] is the target
+    // of stage i % 2
+    void Run(const complex* source, complex* const buffers[2]) const;
+
+    u_int size_;
+    u_int numBits_;
+    c_vector twiddles_;
+    c_vector work_;
+};
+
+#endif // STOCKHAM_H
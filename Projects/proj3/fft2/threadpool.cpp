@@ -0,0 +1,92 @@
+#include "threadpool.h"
+#include <algorithm>
+
+namespace
+{
+    // set while a thread is running a task, so nested
+    // ParallelFor calls fall back to running inline
+    thread_local bool insideTask = false;
+}
+
+ThreadPool::ThreadPool(u_int _threads)
+: task_(nullptr), count_(0), chunk_(1), next_(0)
+, pending_(0), generation_(0), stop_(false)
+{
+    u_int threads = _threads;
+    if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for(u_int i = 1; i < threads; ++i)
+    {
+        workers_.emplace_back(&ThreadPool::Worker, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for(auto& worker : workers_) worker.join();
+}
+
+void ThreadPool::ParallelFor(u_int count, const std::function<void(u_int, u_int)>& task)
+{
+    if(count == 0) return;
+    if(workers_.empty() || insideTask || count == 1)
+    {
+        task(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        // a few ranges per thread so uneven items still balance
+        chunk_ = std::max(1u, count / (Threads() * 4));
+        next_ = 0;
+        pending_ = static_cast<u_int>(workers_.size());
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    RunChunks();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::RunChunks()
+{
+    insideTask = true;
+    while(true)
+    {
+        u_int begin = next_.fetch_add(chunk_);
+        if(begin >= count_) break;
+        u_int end = std::min(count_, begin + chunk_);
+        (*task_)(begin, end);
+    }
+    insideTask = false;
+}
+
+void ThreadPool::Worker()
+{
+    u_int seen = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+            if(stop_) return;
+            seen = generation_;
+        }
+        RunChunks();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --pending_;
+        }
+        done_.notify_one();
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using u_int = unsigned int;
+
+/*
+    Fixed set of worker threads for splitting loops across cores.
+    ParallelFor(count, task) hands out [begin, end) ranges of
+    the index space until all count items are done; the calling
+    thread works too, and the call returns once every range has
+    finished. A ParallelFor issued from inside a task runs inline
+    on that thread instead of deadlocking on the busy pool.
+*/
+class ThreadPool
+{
+public:
+    // 0 -> one thread per hardware core
+    ThreadPool(u_int _threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Workers plus the calling thread
+    u_int Threads() const { return static_cast<u_int>(workers_.size()) + 1; }
+
+    void ParallelFor(u_int count, const std::function<void(u_int, u_int)>& task);
+
+private:
+    void Worker();
+    void RunChunks();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    // current job, guarded by mutex_ except for next_
+    const std::function<void(u_int, u_int)>* task_;
+    u_int count_;
+    u_int chunk_;
+    std::atomic<u_int> next_;
+    u_int pending_;
+    u_int generation_;
+    bool stop_;
+};
+
+#endif // THREADPOOL_H
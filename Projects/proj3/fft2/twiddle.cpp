@@ -0,0 +1,31 @@
+#include "twiddle.h"
+
+namespace
+{
+    u_int Log2(size_t n)
+    {
+        u_int bits = 0;
+        while((size_t(1) << bits) < n) ++bits;
+        return bits;
+    }
+}
+
+SplitTwiddles::SplitTwiddles(size_t _size)
+: size_(_size), lowBits_((Log2(_size) + 1) / 2)
+, lowMask_((size_t(1) << ((Log2(_size) + 1) / 2)) - 1)
+{
+    size_t low = size_t(1) << lowBits_;
+    size_t high = (size_ + low - 1) / low;
+    low_.resize(low);
+    high_.resize(high);
+    for(size_t j = 0; j < low; ++j)
+    {
+        double angle = -2.0 * M_PI * static_cast<double>(j) / static_cast<double>(size_);
+        low_[j] = complex(cos(angle), sin(angle));
+    }
+    for(size_t j = 0; j < high; ++j)
+    {
+        double angle = -2.0 * M_PI * static_cast<double>(j * low) / static_cast<double>(size_);
+        high_[j] = complex(cos(angle), sin(angle));
+    }
+}
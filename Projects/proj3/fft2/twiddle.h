@@ -0,0 +1,39 @@
+#ifndef TWIDDLE_H
+#define TWIDDLE_H
+
+#include <cstddef>
+#include "complex_math.h"
+#include "plan.h"
+
+/*
+    W_N^j for any j < N from two tables of about sqrt(N) entries:
+        j = hi * 2^b + lo        W_N^j = W_N^(hi * 2^b) * W_N^lo
+    with b = ceil(log2(N) / 2). One complex multiply per lookup
+    instead of an N-entry table, which at the sizes FourStepFFT and
+    OutOfCoreFFT are for would be as big as the data and streamed
+    from DRAM next to it; the two small tables stay in cache.
+*/
+class SplitTwiddles
+{
+public:
+    // N a power of two
+    SplitTwiddles(size_t _size);
+
+    // W_N^j, j < N
+    complex At(size_t j) const
+    {
+        const complex& low = low_[j & lowMask_];
+        return Rotate(high_[j >> lowBits_], low.real(), low.imag());
+    }
+
+    size_t Size() const { return size_; }
+
+private:
+    size_t size_;
+    u_int lowBits_;
+    size_t lowMask_;
+    c_vector low_;      // W_N^lo, lo < 2^lowBits_
+    c_vector high_;     // W_N^(hi * 2^lowBits_)
+};
+
+#endif // TWIDDLE_H
@@ -0,0 +1,237 @@
+#include "wisdom.h"
+#include "fft2.h"
+#include "fourstep.h"
+#include "simd.h"
+#include "stockham.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    using tuneClock = std::chrono::steady_clock;
+
+    // shorter than --bench: a whole sweep of sizes should take seconds
+    const double calibrateSeconds = 0.001;
+    const double budgetSeconds = 0.05;
+    const u_int minSamples = 5;
+    const u_int maxSamples = 25;
+
+    // fourstep only pays once the sub-FFTs are worth splitting
+    const u_int fourStepCandidateSize = 1u << 12;
+
+    const char* const wisdomMagic = "fft2-wisdom";
+    const int wisdomVersion = 1;
+
+    double Seconds(tuneClock::time_point start, tuneClock::time_point end)
+    {
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    // seconds for inner calls, each on a fresh copy of input
+    double Sample(const WisdomTransform& transform, const c_vector& input, c_vector& data, u_int inner)
+    {
+        tuneClock::time_point start = tuneClock::now();
+        for(u_int i = 0; i < inner; ++i)
+        {
+            std::copy(input.begin(), input.end(), data.begin());
+            transform(data.data());
+        }
+        return Seconds(start, tuneClock::now());
+    }
+
+    // median seconds per call, as Benchmark::Measure takes it: a
+    // transform re-run on its own output soon reaches inf/NaN and
+    // slows down, so each call gets the input copied back and the
+    // copies, timed on their own, are subtracted
+    double MedianSeconds(const WisdomTransform& transform, const c_vector& input)
+    {
+        c_vector data(input.size());
+        u_int calls = 0;
+        tuneClock::time_point start = tuneClock::now();
+        double elapsed = 0.0;
+        while(elapsed < calibrateSeconds)
+        {
+            Sample(transform, input, data, 1);
+            ++calls;
+            elapsed = Seconds(start, tuneClock::now());
+        }
+        u_int inner = std::max(1u, static_cast<u_int>(calibrateSeconds * calls / elapsed));
+
+        std::vector<double> copies;
+        while(copies.size() < minSamples)
+        {
+            start = tuneClock::now();
+            for(u_int i = 0; i < inner; ++i) std::copy(input.begin(), input.end(), data.begin());
+            copies.push_back(Seconds(start, tuneClock::now()));
+        }
+        std::sort(copies.begin(), copies.end());
+        double copy = copies[copies.size() / 2];
+
+        std::vector<double> times;
+        double spent = 0.0;
+        while(times.size() < minSamples || (spent < budgetSeconds && times.size() < maxSamples))
+        {
+            double seconds = Sample(transform, input, data, inner);
+            spent += seconds;
+            times.push_back(std::max(0.0, seconds - copy) / inner);
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    // what the wisdom is only good for: same vector kernels, same cores
+    string Machine()
+    {
+        std::ostringstream machine;
+        u_int threads = std::max(1u, std::thread::hardware_concurrency());
+        machine << KernelName(BestKernel()) << " " << threads;
+        return machine.str();
+    }
+
+    bool isPowerTwo(u_int N) { return N > 0 && (N & (N - 1)) == 0; }
+}
+
+std::vector<string> Wisdom::Candidates(u_int N)
+{
+    std::vector<string> names;
+    for(int radix = Radix2; radix <= SplitRadix; ++radix)
+    {
+        names.push_back(string("plan-") + RadixName(static_cast<Radix>(radix)));
+    }
+    names.push_back("stockham");
+    for(int kernel = ScalarKernel; kernel <= AVX512Kernel; ++kernel)
+    {
+        Kernel k = static_cast<Kernel>(kernel);
+        if(KernelSupported(k)) names.push_back(string("simd-") + KernelName(k));
+    }
+    names.push_back("recursive");
+    if(N >= fourStepCandidateSize) names.push_back("fourstep");
+    return names;
+}
+
+WisdomTransform Wisdom::Build(const string& name, u_int N)
+{
+    if(!isPowerTwo(N)) return WisdomTransform();
+    for(int radix = Radix2; radix <= SplitRadix; ++radix)
+    {
+        Radix r = static_cast<Radix>(radix);
+        if(name != string("plan-") + RadixName(r)) continue;
+        auto plan = std::make_shared<FFTPlan>(N, r);
+        return [plan](complex* data) { plan->Execute(data); };
+    }
+    for(int kernel = ScalarKernel; kernel <= AVX512Kernel; ++kernel)
+    {
+        Kernel k = static_cast<Kernel>(kernel);
+        if(name != string("simd-") + KernelName(k)) continue;
+        if(!KernelSupported(k)) return WisdomTransform();
+        auto plan = std::make_shared<SimdPlan>(N, k);
+        return [plan](complex* data) { plan->Execute(data); };
+    }
+    if(name == "stockham")
+    {
+        auto stockham = std::make_shared<StockhamFFT>(N);
+        return [stockham](complex* data) { stockham->Execute(data); };
+    }
+    if(name == "recursive")
+    {
+        auto fourier = std::make_shared<FFT>("", N);
+        auto input = std::make_shared<c_vector>(N);
+        auto output = std::make_shared<c_vector>(N);
+        return [fourier, input, output, N](complex* data)
+        {
+            std::copy(data, data + N, input->begin());
+            fourier->Execute(*input, *output);
+            std::copy(output->begin(), output->end(), data);
+        };
+    }
+    if(name == "fourstep")
+    {
+        auto fourStep = std::make_shared<FourStepFFT>(N);
+        return [fourStep](complex* data) { fourStep->Execute(data); };
+    }
+    return WisdomTransform();
+}
+
+const WisdomEntry& Wisdom::Tune(u_int N, std::ostream* log)
+{
+    std::mt19937 random(320);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    c_vector input(N);
+    for(auto& value : input) value = complex(uniform(random), uniform(random));
+
+    WisdomEntry best = {"", 0.0};
+    for(const string& name : Candidates(N))
+    {
+        WisdomTransform transform = Build(name, N);
+        double ns = MedianSeconds(transform, input) * 1e9;
+        if(log)
+        {
+            *log << std::left << std::setw(18) << name << std::right
+            << std::setw(10) << N << std::fixed << std::setprecision(0)
+            << std::setw(14) << ns << std::endl;
+        }
+        if(best.kernel.empty() || ns < best.medianNs) best = {name, ns};
+    }
+    entries_[N] = best;
+    return entries_[N];
+}
+
+const WisdomEntry* Wisdom::Lookup(u_int N) const
+{
+    auto entry = entries_.find(N);
+    return entry == entries_.end() ? nullptr : &entry->second;
+}
+
+bool Wisdom::Load(const string& filename)
+{
+    std::ifstream file(filename);
+    if(!file.is_open()) return false;
+
+    string line, magic;
+    int version = 0;
+    if(!std::getline(file, line)) return false;
+    std::istringstream header(line);
+    header >> magic >> version;
+    string machine;
+    std::getline(header >> std::ws, machine);
+    if(magic != wisdomMagic || version != wisdomVersion || machine != Machine()) return false;
+
+    // read everything before keeping any of it
+    std::map<u_int, WisdomEntry> loaded;
+    while(std::getline(file, line))
+    {
+        if(line.empty()) continue;
+        std::istringstream fields(line);
+        u_int N = 0;
+        WisdomEntry entry;
+        if(!(fields >> N >> entry.kernel >> entry.medianNs) || !isPowerTwo(N)) return false;
+        loaded[N] = entry;
+    }
+    for(const auto& entry : loaded) entries_[entry.first] = entry.second;
+    return true;
+}
+
+bool Wisdom::Save(const string& filename) const
+{
+    std::ofstream file(filename);
+    if(!file.is_open()) return false;
+    file << wisdomMagic << " " << wisdomVersion << " " << Machine() << "\n";
+    for(const auto& entry : entries_)
+    {
+        file << entry.first << " " << entry.second.kernel << " "
+        << std::fixed << std::setprecision(0) << entry.second.medianNs << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+Wisdom& SharedWisdom()
+{
+    static Wisdom wisdom;
+    return wisdom;
+}
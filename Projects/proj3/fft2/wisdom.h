@@ -0,0 +1,75 @@
+#ifndef WISDOM_H
+#define WISDOM_H
+
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "plan.h"
+
+/*
+    Autotuned kernel choice per N ("wisdom", after FFTW's).
+    Which power-of-two kernel is fastest depends on the machine:
+    cache sizes, vector width, core count. Tune(N) builds every
+    candidate for N, times each the way --bench does (calibrate,
+    median of several samples, each call on a fresh copy of the
+    input) and records the fastest. Candidates:
+        plan-radix-2 plan-radix-4 plan-split-radix   FFTPlan
+        stockham                                     StockhamFFT
+        simd-<kernel>                                SimdPlan, if the CPU has it
+        recursive                                    FFT, out of place + copy
+        fourstep                                     FourStepFFT, N >= 2^12
+    A tuned kernel is built with Build(name, N), which also gives
+    the transform FFT2::Execute runs when the shared wisdom has N.
+
+    File format, one text line each:
+        fft2-wisdom 1 <best simd kernel> <threads>
+        <N> <kernel> <median ns>
+    The header names the machine it was tuned on; a file whose
+    header does not match this machine is not loaded.
+*/
+
+// In-place transform of one N-point vector
+using WisdomTransform = std::function<void(complex* data)>;
+
+struct WisdomEntry
+{
+    std::string kernel;
+    double medianNs;
+};
+
+class Wisdom
+{
+public:
+    // Names of the kernels worth timing for N (a power of two)
+    static std::vector<std::string> Candidates(u_int N);
+    // Kernel name for N, or an empty function if the name is
+    // unknown or not supported on this machine
+    static WisdomTransform Build(const std::string& name, u_int N);
+
+    // Times every candidate, records and returns the fastest;
+    // one line per candidate to log if not null
+    const WisdomEntry& Tune(u_int N, std::ostream* log = nullptr);
+    // nullptr if N has not been tuned
+    const WisdomEntry* Lookup(u_int N) const;
+
+    // false if the file cannot be read, is malformed or was tuned
+    // on another machine; entries already held are kept
+    bool Load(const std::string& filename);
+    bool Save(const std::string& filename) const;
+
+    size_t Count() const { return entries_.size(); }
+    const std::map<u_int, WisdomEntry>& Entries() const { return entries_; }
+
+private:
+    std::map<u_int, WisdomEntry> entries_;
+};
+
+// Loaded at startup by the fft2 CLI, consulted by FFT2::Execute
+Wisdom& SharedWisdom();
+
+// Default wisdom file, in the working directory
+const char* const defaultWisdomFile = "fft2.wisdom";
+
+#endif // WISDOM_H
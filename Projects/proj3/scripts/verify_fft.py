@@ -12,7 +12,8 @@ from typing import List, Tuple
 
 def read_complex_file(filename: str) -> List[complex]:
     """
-    Read complex numbers from file (format: real imag per line).
+    Read complex numbers from file (format: real imag per line,
+    or a binary .cvec file).
 
     Args:
         filename: Path to input file
@@ -22,6 +23,13 @@ def read_complex_file(filename: str) -> List[complex]:
     """
     complexes = []
     try:
+        # binary .cvec from fft2 --out: 16-byte header, then re/im doubles
+        with open(filename, 'rb') as f:
+            header = f.read(16)
+            if header[:4] == b'CVEC':
+                count = int.from_bytes(header[8:16], 'little')
+                values = np.frombuffer(f.read(16 * count), dtype='<f8')
+                return list(values[0::2] + 1j * values[1::2])
         with open(filename, 'r') as f:
             for line in f:
                 line = line.strip()
@@ -16,6 +16,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <iostream>
+#include "../../common/goertzel.h"
 using namespace std;
 
 
@@ -54,14 +55,12 @@ int main(int argc, char *argv[]) {
   unsigned wcount = (count - N)/H;
   float *coef = new float[wcount];
   short *samples = reinterpret_cast<short*>(data);
-  // This is the window loop
+  // This is the window loop: one Goertzel bin at DT radians per
+  // sample, windowed in place, no exp() per sample
+  Goertzel partial(DT, N);
   for (unsigned j=0; j < wcount; ++j) {
-    complex<float> z = 0;
-    for (int t=0; t < N; ++t) {
-      complex<float> itx(0,t*DT);
-      z += W[t]*float(samples[j*H+t])*exp(-itx);
-    }
-    coef[j] = abs(z);
+    complex<double> z = partial.Bin(samples + j*H, W);
+    coef[j] = float(abs(z));
   }
 
   // convert to WAVE file